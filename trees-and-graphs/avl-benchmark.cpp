@@ -0,0 +1,196 @@
+#include "binary-search-tree.cpp"
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <string>
+
+using namespace std;
+
+/**
+ * Benchmarks the unbalanced and the AVL Binary Search Tree
+ * Sorted, random and adversarial (zig zag) insertion sequences are used
+ * The zig zag sequence 1, n, 2, n-1 ... degenerates the unbalanced tree
+ * And forces a double rotation on almost every insert into the AVL tree
+ *
+ * Usage: ./avl-benchmark [numAvlKeys] [numUnbalancedKeys]
+ *
+ * @see binary-search-tree.cpp
+ */
+
+/**
+ * Returns the keys 1..n in increasing order
+ *
+ * @param int n
+ * @return vector<int>
+ */
+vector<int> sortedSequence(int n)
+{
+    vector<int> v(n);
+
+    for (int i=0; i<n; i++) v[i] = i+1;
+
+    return v;
+}
+
+/**
+ * Returns the keys 1..n in a random order
+ *
+ * @param int n
+ * @return vector<int>
+ */
+vector<int> randomSequence(int n)
+{
+    vector<int> v = sortedSequence(n);
+
+    shuffle(v.begin(), v.end(), mt19937(42));
+
+    return v;
+}
+
+/**
+ * Returns the keys 1..n alternating between the low and the high end
+ *
+ * @param int n
+ * @return vector<int>
+ */
+vector<int> zigZagSequence(int n)
+{
+    vector<int> v;
+
+    int lo = 1, hi = n;
+
+    while (lo <= hi)
+    {
+        v.push_back(lo++);
+
+        if (lo <= hi) v.push_back(hi--);
+    }
+
+    return v;
+}
+
+/**
+ * Returns the milliseconds elapsed since start
+ *
+ * @param chrono::steady_clock::time_point start
+ * @return double
+ */
+double elapsedMs(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Inserts, looks up and removes every key of the sequence and prints the timings
+ *
+ * @param string name
+ * @param BalanceMode mode
+ * @param vector<int>& keys
+ * @return void
+ */
+void runBenchmark(string name, BalanceMode mode, vector<int>& keys)
+{
+    BinarySearchTree bst = BinarySearchTree(mode);
+
+    auto start = chrono::steady_clock::now();
+
+    for (int key : keys) bst.insert(key);
+
+    double insertMs = elapsedMs(start);
+
+    int height = bst.getHeight();
+
+    bool balanced = bst.getBalanced();
+
+    start = chrono::steady_clock::now();
+
+    int found = 0;
+
+    for (int key : keys) found += bst.exists(key);
+
+    double existsMs = elapsedMs(start);
+
+    start = chrono::steady_clock::now();
+
+    int removed = 0;
+
+    for (int key : keys) removed += bst.remove(key);
+
+    double removeMs = elapsedMs(start);
+
+    printf("%-5s %-8s n=%-8zu height=%-6d balanced=%d insert=%9.2fms exists=%9.2fms remove=%9.2fms found=%d removed=%d\n",
+        mode == BalanceMode::AVL ? "avl" : "plain", name.c_str(), keys.size(), height, balanced,
+        insertMs, existsMs, removeMs, found, removed);
+}
+
+/**
+ * Times building a tree from sorted keys by bulk load, and lookups in it
+ *
+ * @param vector<int>& sorted
+ * @return void
+ */
+void runBulkLoadBenchmark(vector<int>& sorted)
+{
+    BinarySearchTree loaded = BinarySearchTree(BalanceMode::AVL);
+
+    auto start = chrono::steady_clock::now();
+
+    loaded.bulkLoad(sorted);
+
+    double bulkLoadMs = elapsedMs(start);
+
+    start = chrono::steady_clock::now();
+
+    int found = 0;
+
+    for (int key : sorted) found += loaded.exists(key);
+
+    double existsMs = elapsedMs(start);
+
+    printf("avl   bulkload n=%-8zu height=%-6d balanced=%d build=%10.2fms exists=%9.2fms found=%d\n",
+        sorted.size(), loaded.getHeight(), loaded.getBalanced(), bulkLoadMs, existsMs, found);
+}
+
+int main(int argc, char** argv)
+{
+    int numAvlKeys = argc > 1 ? stoi(argv[1]) : 1000000;
+
+    // The unbalanced tree is quadratic and recursion deep on degenerate input
+    int numUnbalancedKeys = argc > 2 ? stoi(argv[2]) : 10000;
+
+    vector<int> sorted = sortedSequence(numUnbalancedKeys);
+
+    vector<int> random = randomSequence(numUnbalancedKeys);
+
+    vector<int> zigZag = zigZagSequence(numUnbalancedKeys);
+
+    runBenchmark("sorted", BalanceMode::NONE, sorted);
+
+    runBenchmark("random", BalanceMode::NONE, random);
+
+    runBenchmark("zigzag", BalanceMode::NONE, zigZag);
+
+    runBenchmark("sorted", BalanceMode::AVL, sorted);
+
+    runBenchmark("random", BalanceMode::AVL, random);
+
+    runBenchmark("zigzag", BalanceMode::AVL, zigZag);
+
+    cout << endl;
+
+    sorted = sortedSequence(numAvlKeys);
+
+    random = randomSequence(numAvlKeys);
+
+    zigZag = zigZagSequence(numAvlKeys);
+
+    runBenchmark("sorted", BalanceMode::AVL, sorted);
+
+    runBenchmark("random", BalanceMode::AVL, random);
+
+    runBenchmark("zigzag", BalanceMode::AVL, zigZag);
+
+    runBulkLoadBenchmark(sorted);
+}
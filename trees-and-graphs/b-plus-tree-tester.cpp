@@ -0,0 +1,78 @@
+#include "b-plus-tree.cpp"
+#include "binary-search-tree.cpp"
+#include <vector>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace std;
+
+/**
+ * Checks the B+ tree against the Binary Search Tree, and compares their memory
+ *
+ * Usage: ./b-plus-tree-tester [numKeys]
+ *
+ * @see b-plus-tree.cpp
+ * @see binary-search-tree.cpp
+ */
+
+int main(int argc, char** argv)
+{
+    BPlusTree small = BPlusTree();
+
+    for (int i=1; i<=200; i++) small.insert(i);
+
+    printf("Height of the B+ tree with 200 keys %d\n", small.getHeight());
+
+    vector<vector<int>> levels = small.levelOrder();
+
+    for (size_t level=0; level<levels.size(); level++)
+    {
+        printf("Level %zu holds %zu keys, starting with %d\n", level, levels[level].size(), levels[level][0]);
+    }
+
+    cout << endl;
+
+    int numKeys = argc > 1 ? stoi(argv[1]) : 1000000;
+
+    BPlusTree bpt = BPlusTree();
+
+    BinarySearchTree bst = BinarySearchTree(BalanceMode::AVL);
+
+    mt19937 rng(42);
+
+    for (int i=0; i<numKeys; i++)
+    {
+        int val = rng() % numKeys;
+
+        bpt.insert(val);
+
+        bst.insert(val);
+    }
+
+    bool matches = bpt.inOrder() == bst.inOrder();
+
+    for (int i=0; i<1000; i++)
+    {
+        int val = rng() % (numKeys + 10);
+
+        int n = 1 + rng() % numKeys;
+
+        matches = matches && bpt.exists(val) == bst.exists(val);
+
+        matches = matches && bpt.getNthRank(n) == bst.getNthRank(n)->getValue();
+    }
+
+    printf("B+ tree matches the BST on %d random keys %d\n", numKeys, matches);
+
+    printf("B+ tree height %d, BST height %d\n", bpt.getHeight(), bst.getHeight());
+
+    printf("B+ tree bytes per key %.2f, BST bytes per key %.2f\n",
+        (double) bpt.getMemoryUsage() / numKeys, (double) sizeof(TreeNode));
+
+    BPlusTree sorted = BPlusTree();
+
+    for (int i=0; i<numKeys; i++) sorted.insert(i);
+
+    printf("B+ tree bytes per key on sorted input %.2f\n", (double) sorted.getMemoryUsage() / numKeys);
+}
@@ -0,0 +1,442 @@
+#include "b-plus-tree.h"
+#include <algorithm>
+#include <queue>
+#include <utility>
+
+using namespace std;
+
+/**
+ * This is an implementation of a B+ tree holding int keys
+ * Nodes are sized to whole cache lines, and hold many keys each
+ * So a key costs a few bytes instead of a full binary tree node
+ */
+
+/**
+ * Creates an empty leaf
+ */
+BPlusLeaf::BPlusLeaf()
+{
+    this->numKeys = 0;
+
+    this->next = nullptr;
+}
+
+/**
+ * Creates an internal node with no children
+ */
+BPlusInternal::BPlusInternal()
+{
+    this->numKeys = 0;
+}
+
+/**
+ * Creates an empty B+ tree
+ */
+BPlusTree::BPlusTree()
+{
+    this->size = 0;
+
+    this->height = 0;
+
+    this->root = nullptr;
+
+    this->head = nullptr;
+
+    this->numLeaves = 0;
+
+    this->numInternals = 0;
+}
+
+/**
+ * Returns the number of keys held in the tree rooted at node
+ *
+ * @param void* node
+ * @param int level
+ * @return int
+ */
+int BPlusTree::countOf(void* node, int level)
+{
+    if (level == 1) return static_cast<BPlusLeaf*>(node)->numKeys;
+
+    BPlusInternal* internal = static_cast<BPlusInternal*>(node);
+
+    int count = 0;
+
+    for (int i=0; i<=internal->numKeys; i++) count += internal->counts[i];
+
+    return count;
+}
+
+/**
+ * Inserts val into the leaf
+ * Returns the new right sibling if the leaf was split
+ *
+ * @param BPlusLeaf* leaf
+ * @param int val
+ * @param int& separator
+ * @return BPlusLeaf*
+ */
+BPlusLeaf* BPlusTree::insertIntoLeaf(BPlusLeaf* leaf, int val, int& separator)
+{
+    int n = leaf->numKeys;
+
+    int pos = upper_bound(leaf->keys, leaf->keys + n, val) - leaf->keys;
+
+    if (n < B_PLUS_LEAF_KEYS)
+    {
+        copy_backward(leaf->keys + pos, leaf->keys + n, leaf->keys + n + 1);
+
+        leaf->keys[pos] = val;
+
+        leaf->numKeys++;
+
+        return nullptr;
+    }
+
+    // The leaf is full, so split the n + 1 keys into two leaves
+    int keys[B_PLUS_LEAF_KEYS + 1];
+
+    copy(leaf->keys, leaf->keys + pos, keys);
+
+    keys[pos] = val;
+
+    copy(leaf->keys + pos, leaf->keys + n, keys + pos + 1);
+
+    // Appending to the right most leaf keeps it full, so sorted loads pack densely
+    int half = (pos == n && !leaf->next) ? n : (n + 1) / 2;
+
+    BPlusLeaf* sibling = new BPlusLeaf();
+
+    this->numLeaves++;
+
+    copy(keys, keys + half, leaf->keys);
+
+    leaf->numKeys = half;
+
+    copy(keys + half, keys + n + 1, sibling->keys);
+
+    sibling->numKeys = n + 1 - half;
+
+    sibling->next = leaf->next;
+
+    leaf->next = sibling;
+
+    separator = sibling->keys[0];
+
+    return sibling;
+}
+
+/**
+ * Recursively inserts val into the tree rooted at node
+ * Returns the new right sibling if node was split
+ *
+ * @param void* node
+ * @param int level
+ * @param int val
+ * @param int& separator
+ * @return void*
+ */
+void* BPlusTree::recursiveInsert(void* node, int level, int val, int& separator)
+{
+    if (level == 1) return this->insertIntoLeaf(static_cast<BPlusLeaf*>(node), val, separator);
+
+    BPlusInternal* internal = static_cast<BPlusInternal*>(node);
+
+    int n = internal->numKeys;
+
+    int i = upper_bound(internal->keys, internal->keys + n, val) - internal->keys;
+
+    int childSeparator;
+
+    void* child = internal->children[i];
+
+    void* childSibling = this->recursiveInsert(child, level-1, val, childSeparator);
+
+    if (!childSibling)
+    {
+        internal->counts[i]++;
+
+        return nullptr;
+    }
+
+    // Lay out the n + 1 separators and n + 2 children, with the new child at i + 1
+    int keys[B_PLUS_INTERNAL_KEYS + 1];
+
+    int counts[B_PLUS_INTERNAL_KEYS + 2];
+
+    void* children[B_PLUS_INTERNAL_KEYS + 2];
+
+    copy(internal->keys, internal->keys + i, keys);
+
+    keys[i] = childSeparator;
+
+    copy(internal->keys + i, internal->keys + n, keys + i + 1);
+
+    copy(internal->children, internal->children + i + 1, children);
+
+    children[i+1] = childSibling;
+
+    copy(internal->children + i + 1, internal->children + n + 1, children + i + 2);
+
+    copy(internal->counts, internal->counts + i, counts);
+
+    counts[i] = this->countOf(child, level-1);
+
+    counts[i+1] = this->countOf(childSibling, level-1);
+
+    copy(internal->counts + i + 1, internal->counts + n + 1, counts + i + 2);
+
+    n++;
+
+    if (n <= B_PLUS_INTERNAL_KEYS)
+    {
+        copy(keys, keys + n, internal->keys);
+
+        copy(children, children + n + 1, internal->children);
+
+        copy(counts, counts + n + 1, internal->counts);
+
+        internal->numKeys = n;
+
+        return nullptr;
+    }
+
+    // The node overflows, so the middle separator moves up to the parent
+    int mid = n / 2;
+
+    BPlusInternal* sibling = new BPlusInternal();
+
+    this->numInternals++;
+
+    copy(keys, keys + mid, internal->keys);
+
+    copy(children, children + mid + 1, internal->children);
+
+    copy(counts, counts + mid + 1, internal->counts);
+
+    internal->numKeys = mid;
+
+    copy(keys + mid + 1, keys + n, sibling->keys);
+
+    copy(children + mid + 1, children + n + 1, sibling->children);
+
+    copy(counts + mid + 1, counts + n + 1, sibling->counts);
+
+    sibling->numKeys = n - mid - 1;
+
+    separator = keys[mid];
+
+    return sibling;
+}
+
+/**
+ * Inserts a new key into the B+ tree
+ *
+ * @param int val
+ * @return void
+ */
+void BPlusTree::insert(int val)
+{
+    this->size++;
+
+    if (!this->root)
+    {
+        BPlusLeaf* leaf = new BPlusLeaf();
+
+        this->numLeaves++;
+
+        leaf->keys[0] = val;
+
+        leaf->numKeys = 1;
+
+        this->root = leaf;
+
+        this->head = leaf;
+
+        this->height = 1;
+
+        return;
+    }
+
+    int separator;
+
+    void* sibling = this->recursiveInsert(this->root, this->height, val, separator);
+
+    if (!sibling) return;
+
+    // The root was split, so the tree grows by one level
+    BPlusInternal* newRoot = new BPlusInternal();
+
+    this->numInternals++;
+
+    newRoot->numKeys = 1;
+
+    newRoot->keys[0] = separator;
+
+    newRoot->children[0] = this->root;
+
+    newRoot->children[1] = sibling;
+
+    newRoot->counts[0] = this->countOf(this->root, this->height);
+
+    newRoot->counts[1] = this->countOf(sibling, this->height);
+
+    this->root = newRoot;
+
+    this->height++;
+}
+
+/**
+ * Checks whether a key exists in the B+ tree
+ *
+ * @param int val
+ * @return bool
+ */
+bool BPlusTree::exists(int val)
+{
+    if (!this->root) return false;
+
+    void* node = this->root;
+
+    for (int level=this->height; level>1; level--)
+    {
+        BPlusInternal* internal = static_cast<BPlusInternal*>(node);
+
+        int i = lower_bound(internal->keys, internal->keys + internal->numKeys, val) - internal->keys;
+
+        node = internal->children[i];
+    }
+
+    BPlusLeaf* leaf = static_cast<BPlusLeaf*>(node);
+
+    int pos = lower_bound(leaf->keys, leaf->keys + leaf->numKeys, val) - leaf->keys;
+
+    if (pos < leaf->numKeys) return leaf->keys[pos] == val;
+
+    // Keys equal to a separator may start the next leaf
+    return leaf->next && leaf->next->keys[0] == val;
+}
+
+/**
+ * Returns the number of keys in the B+ tree
+ *
+ * @return int
+ */
+int BPlusTree::getNumVertices()
+{
+    return this->size;
+}
+
+/**
+ * Returns all keys in order by scanning the leaves
+ *
+ * @return vector<int>
+ */
+vector<int> BPlusTree::inOrder()
+{
+    vector<int> res;
+
+    res.reserve(this->size);
+
+    for (BPlusLeaf* leaf = this->head; leaf; leaf = leaf->next)
+    {
+        res.insert(res.end(), leaf->keys, leaf->keys + leaf->numKeys);
+    }
+
+    return res;
+}
+
+/**
+ * Returns the keys of each level, separators first and leaf keys last
+ *
+ * @return vector<vector<int>>
+ */
+vector<vector<int>> BPlusTree::levelOrder()
+{
+    vector<vector<int>> res(this->height, vector<int>());
+
+    if (this->height == 0) return res;
+
+    queue<pair<void*, int>> levelOrderQ;
+
+    levelOrderQ.push(make_pair(this->root, 0));
+
+    while (!levelOrderQ.empty())
+    {
+        pair<void*, int> p = levelOrderQ.front();
+
+        levelOrderQ.pop();
+
+        int currentLevel = p.second;
+
+        if (currentLevel == this->height - 1)
+        {
+            BPlusLeaf* leaf = static_cast<BPlusLeaf*>(p.first);
+
+            res[currentLevel].insert(res[currentLevel].end(), leaf->keys, leaf->keys + leaf->numKeys);
+
+            continue;
+        }
+
+        BPlusInternal* internal = static_cast<BPlusInternal*>(p.first);
+
+        res[currentLevel].insert(res[currentLevel].end(), internal->keys, internal->keys + internal->numKeys);
+
+        for (int i=0; i<=internal->numKeys; i++)
+        {
+            levelOrderQ.push(make_pair(internal->children[i], currentLevel+1));
+        }
+    }
+
+    return res;
+}
+
+/**
+ * Returns the number of levels in the tree
+ *
+ * @return int
+ */
+int BPlusTree::getHeight()
+{
+    return this->height;
+}
+
+/**
+ * Gets the nth key by in order
+ * n must be in the range [1, numVertices]
+ *
+ * @param int n
+ * @return int
+ */
+int BPlusTree::getNthRank(int n)
+{
+    void* node = this->root;
+
+    for (int level=this->height; level>1; level--)
+    {
+        BPlusInternal* internal = static_cast<BPlusInternal*>(node);
+
+        int i = 0;
+
+        while (i < internal->numKeys && n > internal->counts[i])
+        {
+            n -= internal->counts[i];
+
+            i++;
+        }
+
+        node = internal->children[i];
+    }
+
+    return static_cast<BPlusLeaf*>(node)->keys[n-1];
+}
+
+/**
+ * Returns the number of bytes allocated for the nodes of the tree
+ *
+ * @return size_t
+ */
+size_t BPlusTree::getMemoryUsage()
+{
+    return this->numLeaves * sizeof(BPlusLeaf) + this->numInternals * sizeof(BPlusInternal);
+}
@@ -0,0 +1,236 @@
+#ifndef B_PLUS_TREE
+#define B_PLUS_TREE
+
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * Number of keys held by a leaf, so that a leaf spans 4 cache lines
+ */
+const int B_PLUS_LEAF_KEYS = 60;
+
+/**
+ * Number of keys held by an internal node, so that it spans 8 cache lines
+ */
+const int B_PLUS_INTERNAL_KEYS = 31;
+
+class BPlusLeaf
+{
+    public:
+        /**
+         * Number of keys held in the leaf
+         *
+         * @param int numKeys
+         */
+        int numKeys;
+
+        /**
+         * Keys held in the leaf, sorted in increasing order
+         *
+         * @param int keys[]
+         */
+        int keys[B_PLUS_LEAF_KEYS];
+
+        /**
+         * Next leaf in order, used for sequential scans
+         *
+         * @param BPlusLeaf* next
+         */
+        BPlusLeaf* next;
+
+        /**
+         * Creates an empty leaf
+         */
+        BPlusLeaf();
+};
+
+class BPlusInternal
+{
+    public:
+        /**
+         * Number of separator keys held in the node
+         * The node has numKeys + 1 children
+         *
+         * @param int numKeys
+         */
+        int numKeys;
+
+        /**
+         * Separator keys: keys of child i <= keys[i] <= keys of child i+1
+         *
+         * @param int keys[]
+         */
+        int keys[B_PLUS_INTERNAL_KEYS];
+
+        /**
+         * Number of keys held in the tree rooted at each child
+         *
+         * @param int counts[]
+         */
+        int counts[B_PLUS_INTERNAL_KEYS + 1];
+
+        /**
+         * Children of the node, leaves if the node is on the lowest internal level
+         *
+         * @param void* children[]
+         */
+        void* children[B_PLUS_INTERNAL_KEYS + 1];
+
+        /**
+         * Creates an internal node with no children
+         */
+        BPlusInternal();
+};
+
+/**
+ * B+ tree of ints exposing the read and insert interface of BinarySearchTree
+ * All keys live in the leaves, which are linked together in order
+ */
+class BPlusTree
+{
+    private:
+        /**
+         * Number of keys in the tree
+         *
+         * @param int size
+         */
+        int size;
+
+        /**
+         * Number of levels in the tree, 0 for an empty tree
+         * Level 1 holds the leaves
+         *
+         * @param int height
+         */
+        int height;
+
+        /**
+         * Root of the tree, a leaf when the height is 1
+         *
+         * @param void* root
+         */
+        void* root;
+
+        /**
+         * Left most leaf of the tree
+         *
+         * @param BPlusLeaf* head
+         */
+        BPlusLeaf* head;
+
+        /**
+         * Number of leaves allocated
+         *
+         * @param int numLeaves
+         */
+        int numLeaves;
+
+        /**
+         * Number of internal nodes allocated
+         *
+         * @param int numInternals
+         */
+        int numInternals;
+
+        /**
+         * Returns the number of keys held in the tree rooted at node
+         *
+         * @param void* node
+         * @param int level
+         * @return int
+         */
+        int countOf(void* node, int level);
+
+        /**
+         * Inserts val into the leaf
+         * Returns the new right sibling if the leaf was split
+         *
+         * @param BPlusLeaf* leaf
+         * @param int val
+         * @param int& separator
+         * @return BPlusLeaf*
+         */
+        BPlusLeaf* insertIntoLeaf(BPlusLeaf* leaf, int val, int& separator);
+
+        /**
+         * Recursively inserts val into the tree rooted at node
+         * Returns the new right sibling if node was split
+         *
+         * @param void* node
+         * @param int level
+         * @param int val
+         * @param int& separator
+         * @return void*
+         */
+        void* recursiveInsert(void* node, int level, int val, int& separator);
+
+    public:
+        /**
+         * Creates an empty B+ tree
+         */
+        BPlusTree();
+
+        /**
+         * Inserts a new key into the B+ tree
+         *
+         * @param int val
+         * @return void
+         */
+        void insert(int val);
+
+        /**
+         * Checks whether a key exists in the B+ tree
+         *
+         * @param int val
+         * @return bool
+         */
+        bool exists(int val);
+
+        /**
+         * Returns the number of keys in the B+ tree
+         *
+         * @return int
+         */
+        int getNumVertices();
+
+        /**
+         * Returns all keys in order by scanning the leaves
+         *
+         * @return vector<int>
+         */
+        vector<int> inOrder();
+
+        /**
+         * Returns the keys of each level, separators first and leaf keys last
+         *
+         * @return vector<vector<int>>
+         */
+        vector<vector<int>> levelOrder();
+
+        /**
+         * Returns the number of levels in the tree
+         *
+         * @return int
+         */
+        int getHeight();
+
+        /**
+         * Gets the nth key by in order
+         * n must be in the range [1, numVertices]
+         *
+         * @param int n
+         * @return int
+         */
+        int getNthRank(int n);
+
+        /**
+         * Returns the number of bytes allocated for the nodes of the tree
+         *
+         * @return size_t
+         */
+        size_t getMemoryUsage();
+};
+
+#endif
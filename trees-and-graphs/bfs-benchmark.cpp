@@ -0,0 +1,210 @@
+#include "directed-graph.cpp"
+#include "parallel-bfs.cpp"
+#include "bidirectional-bfs.cpp"
+#include <vector>
+#include <queue>
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+/**
+ * Benchmarks breadth first search over a random directed graph
+ * A queue based search, the parallel search run top down only, and the
+ * Direction optimizing parallel search all compute the distance of every
+ * Vertex from the same source, and their distances are checked to match
+ * Then random point to point queries are answered by a queue based search
+ * That stops at the end vertex, and by a bidirectional search
+ *
+ * Usage: ./bfs-benchmark [numVertices] [averageDegree] [numThreads] [numQueries]
+ *
+ * @see parallel-bfs.cpp
+ */
+
+/**
+ * Returns the milliseconds elapsed since start
+ *
+ * @param chrono::steady_clock::time_point start
+ * @return double
+ */
+double elapsedMs(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Returns the distance of every vertex from source, by a queue based search
+ *
+ * @param DirectedGraph& dg
+ * @param int source
+ * @return vector<int>
+ */
+vector<int> queueBfs(DirectedGraph& dg, int source)
+{
+    vector<int> distances(dg.getNumVertices(), -1);
+
+    queue<int> bfs;
+
+    bfs.push(source);
+
+    distances[source] = 0;
+
+    while (!bfs.empty())
+    {
+        int u = bfs.front();
+
+        bfs.pop();
+
+        for (int v : dg.neighbors(u))
+        {
+            if (distances[v] >= 0) continue;
+
+            distances[v] = distances[u] + 1;
+
+            bfs.push(v);
+        }
+    }
+
+    return distances;
+}
+
+/**
+ * Returns whether a path exists from start to end, by a queue based search
+ * Adds the number of edges examined to edgesExamined
+ *
+ * @param DirectedGraph& dg
+ * @param int start
+ * @param int end
+ * @param vector<bool>& visited
+ * @param long long& edgesExamined
+ * @return bool
+ */
+bool queuePathExists(DirectedGraph& dg, int start, int end, vector<bool>& visited, long long& edgesExamined)
+{
+    visited.assign(dg.getNumVertices(), false);
+
+    if (start == end) return true;
+
+    queue<int> bfs;
+
+    bfs.push(start);
+
+    visited[start] = true;
+
+    while (!bfs.empty())
+    {
+        int u = bfs.front();
+
+        bfs.pop();
+
+        for (int v : dg.neighbors(u))
+        {
+            edgesExamined++;
+
+            if (visited[v]) continue;
+
+            if (v == end) return true;
+
+            visited[v] = true;
+
+            bfs.push(v);
+        }
+    }
+
+    return false;
+}
+
+int main(int argc, char** argv)
+{
+    int numVertices = argc > 1 ? stoi(argv[1]) : 1 << 20;
+
+    int averageDegree = argc > 2 ? stoi(argv[2]) : 16;
+
+    int numThreads = argc > 3 ? stoi(argv[3]) : thread::hardware_concurrency();
+
+    int numQueries = argc > 4 ? stoi(argv[4]) : 100;
+
+    mt19937 rng(42);
+
+    DirectedGraph dg = DirectedGraph(numVertices);
+
+    auto start = chrono::steady_clock::now();
+
+    for (long long i=0; i<(long long) numVertices * averageDegree; i++)
+    {
+        dg.addEdge(rng() % numVertices, rng() % numVertices);
+    }
+
+    dg.finalize();
+
+    double finalizeMs = elapsedMs(start);
+
+    start = chrono::steady_clock::now();
+
+    dg.buildReverse();
+
+    double reverseMs = elapsedMs(start);
+
+    printf("V=%d E=%d threads=%d build=%.2fms reverse=%.2fms\n", numVertices, dg.getNumEdges(), numThreads, finalizeMs, reverseMs);
+
+    start = chrono::steady_clock::now();
+
+    vector<int> expected = queueBfs(dg, 0);
+
+    printf("%-20s %9.2fms\n", "queue", elapsedMs(start));
+
+    ParallelBfs bfs = ParallelBfs(dg, numThreads);
+
+    for (bool directionOptimizing : {false, true})
+    {
+        start = chrono::steady_clock::now();
+
+        bfs.run(0, directionOptimizing);
+
+        double ms = elapsedMs(start);
+
+        printf("%-20s %9.2fms top down steps=%d bottom up steps=%d edges examined=%lld match=%d\n",
+            directionOptimizing ? "direction optimizing" : "top down", ms, bfs.getTopDownSteps(),
+            bfs.getBottomUpSteps(), bfs.getEdgesExamined(), bfs.getDistances() == expected);
+    }
+
+    cout << endl;
+
+    vector<pair<int, int>> queries(numQueries);
+
+    for (pair<int, int>& query : queries) query = {(int) (rng() % numVertices), (int) (rng() % numVertices)};
+
+    vector<bool> visited;
+
+    long long queueEdges = 0, bidirectionalEdges = 0;
+
+    int queueFound = 0, bidirectionalFound = 0;
+
+    start = chrono::steady_clock::now();
+
+    for (pair<int, int>& query : queries) queueFound += queuePathExists(dg, query.first, query.second, visited, queueEdges);
+
+    double queueMs = elapsedMs(start);
+
+    BidirectionalBfs search = BidirectionalBfs(dg);
+
+    start = chrono::steady_clock::now();
+
+    for (pair<int, int>& query : queries)
+    {
+        bidirectionalFound += search.pathExists(query.first, query.second);
+
+        bidirectionalEdges += search.getEdgesExamined();
+    }
+
+    double bidirectionalMs = elapsedMs(start);
+
+    printf("%-20s %9.2fms for %d queries, %lld edges examined per query, found=%d\n", "queue point to point",
+        queueMs, numQueries, queueEdges / max(numQueries, 1), queueFound);
+
+    printf("%-20s %9.2fms for %d queries, %lld edges examined per query, found=%d\n", "bidirectional",
+        bidirectionalMs, numQueries, bidirectionalEdges / max(numQueries, 1), bidirectionalFound);
+}
@@ -0,0 +1,173 @@
+#include "bidirectional-bfs.h"
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+
+/**
+ * Creates a search over graph
+ *
+ * @param DirectedGraph& graph
+ */
+BidirectionalBfs::BidirectionalBfs(DirectedGraph& graph)
+{
+    this->graph = &graph;
+
+    int n = graph.getNumVertices();
+
+    this->stamp = 0;
+
+    this->forwardStamp.assign(n, 0);
+
+    this->backwardStamp.assign(n, 0);
+
+    this->forwardParent.assign(n, -1);
+
+    this->backwardParent.assign(n, -1);
+
+    this->meeting = -1;
+
+    this->lastQuery = {-1, -1};
+
+    this->edgesExamined = 0;
+}
+
+/**
+ * Expands one level of a search, into next
+ * Returns a vertex reached by the other search, -1 if none
+ *
+ * @param vector<int>& frontier
+ * @param vector<int>& next
+ * @param bool forward
+ * @return int
+ */
+int BidirectionalBfs::expand(vector<int>& frontier, vector<int>& next, bool forward)
+{
+    vector<int>& mine = forward ? this->forwardStamp : this->backwardStamp;
+
+    vector<int>& other = forward ? this->backwardStamp : this->forwardStamp;
+
+    vector<int>& parent = forward ? this->forwardParent : this->backwardParent;
+
+    next.clear();
+
+    for (int u : frontier)
+    {
+        NeighborRange range = forward ? this->graph->neighbors(u) : this->graph->reverseNeighbors(u);
+
+        for (int v : range)
+        {
+            this->edgesExamined++;
+
+            if (mine[v] == this->stamp) continue;
+
+            mine[v] = this->stamp;
+
+            parent[v] = u;
+
+            if (other[v] == this->stamp) return v;
+
+            next.push_back(v);
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * Returns whether a path exists from start to end
+ *
+ * @param int start
+ * @param int end
+ * @return bool
+ */
+bool BidirectionalBfs::pathExists(int start, int end)
+{
+    this->meeting = -1;
+
+    this->lastQuery = {start, end};
+
+    this->edgesExamined = 0;
+
+    if (!this->graph->isVertexValid(start) || !this->graph->isVertexValid(end)) return false;
+
+    this->graph->buildReverse();
+
+    // Stamps only repeat after every mark has been wiped
+    if (this->stamp == numeric_limits<int>::max())
+    {
+        fill(this->forwardStamp.begin(), this->forwardStamp.end(), 0);
+
+        fill(this->backwardStamp.begin(), this->backwardStamp.end(), 0);
+
+        this->stamp = 0;
+    }
+
+    this->stamp++;
+
+    this->forwardStamp[start] = this->stamp;
+
+    this->forwardParent[start] = start;
+
+    this->backwardStamp[end] = this->stamp;
+
+    this->backwardParent[end] = end;
+
+    if (start == end)
+    {
+        this->meeting = start;
+
+        return true;
+    }
+
+    vector<int> forwardFrontier = {start}, backwardFrontier = {end}, next;
+
+    while (!forwardFrontier.empty() && !backwardFrontier.empty())
+    {
+        bool forward = forwardFrontier.size() <= backwardFrontier.size();
+
+        vector<int>& frontier = forward ? forwardFrontier : backwardFrontier;
+
+        this->meeting = this->expand(frontier, next, forward);
+
+        if (this->meeting >= 0) return true;
+
+        swap(frontier, next);
+    }
+
+    // One side ran out of vertices without meeting the other
+    return false;
+}
+
+/**
+ * Returns a path from start to end found by the last query, empty if none
+ *
+ * @return vector<int>
+ */
+vector<int> BidirectionalBfs::getPath()
+{
+    vector<int> path;
+
+    if (this->meeting < 0) return path;
+
+    for (int v = this->meeting; v != this->lastQuery.first; v = this->forwardParent[v]) path.push_back(v);
+
+    path.push_back(this->lastQuery.first);
+
+    reverse(path.begin(), path.end());
+
+    for (int v = this->meeting; v != this->lastQuery.second; v = this->backwardParent[v]) path.push_back(this->backwardParent[v]);
+
+    return path;
+}
+
+/**
+ * Returns the number of edges examined by the last query
+ *
+ * @return long long
+ */
+long long BidirectionalBfs::getEdgesExamined()
+{
+    return this->edgesExamined;
+}
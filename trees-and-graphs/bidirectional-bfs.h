@@ -0,0 +1,127 @@
+#ifndef BIDIRECTIONAL_BFS
+#define BIDIRECTIONAL_BFS
+
+#include "directed-graph.h"
+#include <vector>
+
+using namespace std;
+
+/**
+ * Point to point reachability by bidirectional breadth first search
+ * One search runs forward from the start over out edges, the other backward
+ * From the end over the in edges of the lazily built reverse CSR
+ * Every round expands one whole level of the side with the smaller frontier,
+ * And the search stops as soon as a vertex is reached from both sides, so a
+ * Query explores about two balls of half the distance instead of one
+ * Marks are stamped with the query number, so a query never clears O(V) state
+ */
+class BidirectionalBfs
+{
+    private:
+        /**
+         * Graph being searched
+         *
+         * @param DirectedGraph* graph
+         */
+        DirectedGraph* graph;
+
+        /**
+         * Number of the current query, marks from other queries are stale
+         *
+         * @param int stamp
+         */
+        int stamp;
+
+        /**
+         * Query that last reached each vertex forward
+         *
+         * @param vector<int> forwardStamp
+         */
+        vector<int> forwardStamp;
+
+        /**
+         * Query that last reached each vertex backward
+         *
+         * @param vector<int> backwardStamp
+         */
+        vector<int> backwardStamp;
+
+        /**
+         * Predecessor of each vertex on the forward search, towards the start
+         *
+         * @param vector<int> forwardParent
+         */
+        vector<int> forwardParent;
+
+        /**
+         * Successor of each vertex on the backward search, towards the end
+         *
+         * @param vector<int> backwardParent
+         */
+        vector<int> backwardParent;
+
+        /**
+         * Vertex where the searches met in the last query, -1 if they didn't
+         *
+         * @param int meeting
+         */
+        int meeting;
+
+        /**
+         * Start and end of the last query
+         *
+         * @param pair<int, int> lastQuery
+         */
+        pair<int, int> lastQuery;
+
+        /**
+         * Number of edges examined by the last query
+         *
+         * @param long long edgesExamined
+         */
+        long long edgesExamined;
+
+        /**
+         * Expands one level of a search, into next
+         * Returns a vertex reached by the other search, -1 if none
+         *
+         * @param vector<int>& frontier
+         * @param vector<int>& next
+         * @param bool forward
+         * @return int
+         */
+        int expand(vector<int>& frontier, vector<int>& next, bool forward);
+
+    public:
+        /**
+         * Creates a search over graph
+         *
+         * @param DirectedGraph& graph
+         */
+        BidirectionalBfs(DirectedGraph& graph);
+
+        /**
+         * Returns whether a path exists from start to end
+         *
+         * @param int start
+         * @param int end
+         * @return bool
+         */
+        bool pathExists(int start, int end);
+
+        /**
+         * Returns a path from start to end found by the last query, empty if none
+         *
+         * @return vector<int>
+         */
+        vector<int> getPath();
+
+        /**
+         * Returns the number of edges examined by the last query
+         *
+         * @return long long
+         */
+        long long getEdgesExamined();
+};
+
+#endif
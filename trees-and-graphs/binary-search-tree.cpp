@@ -1,10 +1,15 @@
 #include "binary-search-tree.h"
 #include <vector>
-#include <queue>
 #include <utility>
 #include <iostream>
 #include <list>
 #include <unordered_map>
+#include <thread>
+#include <new>
+#include <memory>
+#include <functional>
+#include <atomic>
+#include <algorithm>
 
 using namespace std;
 
@@ -18,356 +23,1411 @@ BinarySearchTree::BinarySearchTree()
     this->size = 0;
 
     this->root = NULL;
+
+    this->mode = BalanceMode::NONE;
+
+    this->subtreeIndexStale = true;
+
+    this->unbalancedNodes = 0;
+
+    this->hashesStale = false;
 }
 
 /**
- * Recursively inserts a new node into the Binary Search Tree
+ * Creates an empty Binary Search Tree with the given balancing strategy
  *
- * @param TreeNode* curr
- * @param int val
- * @return TreeNode*
+ * @param BalanceMode mode
  */
-TreeNode* BinarySearchTree::recursiveInsert(TreeNode* curr, int val)
+BinarySearchTree::BinarySearchTree(BalanceMode mode)
 {
-    if (!curr) return new TreeNode(val);
+    this->size = 0;
 
-    if (curr->value >= val)
-    {
-        TreeNode* left = recursiveInsert(curr->left, val);
+    this->root = NULL;
 
-        curr->setLeftChild(left);
-    }
-    else
-    {
-        TreeNode* right = recursiveInsert(curr->right, val);
+    this->mode = mode;
 
-        curr->setRightChild(right);
-    }
+    this->subtreeIndexStale = true;
 
-    curr->setHeight();
+    this->unbalancedNodes = 0;
 
-    return curr;
+    this->hashesStale = false;
 }
 
 /**
- * Inserts a new node into the Binary Search Tree
+ * Recomputes the height, size, sum, hash and balance flag of curr from its children
+ * And marks curr as touched since the last validation
  *
- * @param int val
+ * @param TreeNode* curr
  * @return void
  */
-void BinarySearchTree::insert(int val)
+void BinarySearchTree::updateNode(TreeNode* curr)
 {
-    this->root = this->recursiveInsert(this->root, val);
+    this->updateCounts(curr);
 
-    this->size++;
+    curr->setHash();
 }
 
 /**
- * Finds the TreeNode* that contains val, if exists
+ * Recomputes the height, size, sum and balance flag of curr from its children
+ * And marks curr as touched since the last validation
+ * The hash is left alone, splay rotations mark the hashes stale instead
  *
  * @param TreeNode* curr
- * @param int val
- * @return TreeNode*
+ * @return void
  */
-TreeNode* BinarySearchTree::find(TreeNode* curr, int val)
+void BinarySearchTree::updateCounts(TreeNode* curr)
 {
-    if (!curr) return curr;
+    curr->setHeight();
+
+    curr->setSize();
+
+    curr->setSum();
+
+    bool unbalanced = abs(this->getBalanceFactor(curr)) > 1;
 
-    else if (curr->value == val) return curr;
+    this->unbalancedNodes += (int) unbalanced - (int) curr->unbalanced;
 
-    else if (curr->value >= val) return this->find(curr->left, val);
+    curr->unbalanced = unbalanced;
 
-    return this->find(curr->right, val);
+    // Every ancestor of a change is updated, so touched nodes hang off the root
+    curr->touched = true;
+
+    this->subtreeIndexStale = true;
 }
 
 /**
- * Checks whether a value exists in the BST
+ * Recomputes the structural hash of every node of the tree rooted at root, in O(n)
+ * Nodes are hashed in reverse pre order, so children come before their parent
  *
- * @param int val
- * @return bool
+ * @param TreeNode* root
+ * @return void
  */
-bool BinarySearchTree::exists(int val)
+void BinarySearchTree::computeHashes(TreeNode* root)
 {
-    TreeNode* curr = this->find(this->root, val);
+    vector<TreeNode*> nodes;
 
-    return curr != NULL;
+    PreOrderIterator it = PreOrderIterator(root);
+
+    while (it.hasNext()) nodes.push_back(it.nextNode());
+
+    for (int i=(int) nodes.size()-1; i>=0; i--) nodes[i]->setHash();
 }
 
 /**
- * Returns the number of vertices in the BST
+ * Returns the structural hash of the tree rooted at root, without changing it, in O(n)
+ * Nodes are visited root, right, left, so in reverse children come before their parent
+ * And the hashes of a node's subtrees are the top two of the stack
  *
- * @return int
+ * @param TreeNode* root
+ * @return unsigned long long
  */
-int BinarySearchTree::getNumVertices()
+unsigned long long BinarySearchTree::hashOf(TreeNode* root)
 {
-    return this->size;
+    if (!root) return EMPTY_HASH;
+
+    vector<TreeNode*> stack = {root}, nodes;
+
+    while (!stack.empty())
+    {
+        TreeNode* curr = stack.back();
+
+        stack.pop_back();
+
+        nodes.push_back(curr);
+
+        if (curr->left) stack.push_back(curr->left);
+
+        if (curr->right) stack.push_back(curr->right);
+    }
+
+    vector<unsigned long long> hashes;
+
+    for (int i=(int) nodes.size()-1; i>=0; i--)
+    {
+        unsigned long long hashR = EMPTY_HASH, hashL = EMPTY_HASH;
+
+        if (nodes[i]->right)
+        {
+            hashR = hashes.back();
+
+            hashes.pop_back();
+        }
+
+        if (nodes[i]->left)
+        {
+            hashL = hashes.back();
+
+            hashes.pop_back();
+        }
+
+        hashes.push_back(TreeNode::combineHash(nodes[i]->value, hashL, hashR));
+    }
+
+    return hashes.back();
 }
 
 /**
- * Returns the entire tree inOrder
+ * Recomputes the structural hashes if splay rotations left them out of date
  *
- * @param TreeNode* curr
- * @param vector<int>& res
  * @return void
  */
-void BinarySearchTree::inOrder(TreeNode* curr, vector<int>& res)
+void BinarySearchTree::refreshHashes()
 {
-    if (!curr) return;
+    if (!this->hashesStale) return;
 
-    this->inOrder(curr->left, res);
+    computeHashes(this->root);
 
-    res.push_back(curr->value);
-
-    this->inOrder(curr->right, res);
+    this->hashesStale = false;
 }
 
 /**
- * Returns the entire tree inOrder
+ * Returns height(left) - height(right) of curr
  *
- * @return vector<int>
+ * @param TreeNode* curr
+ * @return int
  */
-vector<int> BinarySearchTree::inOrder()
+int BinarySearchTree::getBalanceFactor(TreeNode* curr)
 {
-    vector<int> res;
+    if (!curr) return 0;
 
-    this->inOrder(this->root, res);
+    int left = curr->left ? curr->left->getHeight() : 0;
 
-    return res;
+    int right = curr->right ? curr->right->getHeight() : 0;
+
+    return left - right;
 }
 
 /**
- * Returns the entire tree levelOrder
+ * Rotates the tree rooted at curr to the left
+ * The caller is responsible for re-attaching the returned root to its parent
  *
- * @return vector<vector<int>>
+ * @param TreeNode* curr
+ * @return TreeNode*
  */
-vector<vector<int>> BinarySearchTree::levelOrder()
+TreeNode* BinarySearchTree::rotateLeft(TreeNode* curr)
 {
-    int levels = this->getHeight();
+    TreeNode* pivot = curr->right;
 
-    vector<vector<int>> res(levels, vector<int>());
+    curr->setRightChild(pivot->left);
 
-    if (levels == 0) return res;
+    pivot->setLeftChild(curr);
 
-    queue<pair<TreeNode*, int>> levelOrderQ;
+    this->updateNode(curr);
 
-    levelOrderQ.push(make_pair(this->root, 0));
+    this->updateNode(pivot);
 
-    while (!levelOrderQ.empty())
-    {
-        pair<TreeNode*, int> p = levelOrderQ.front();
-
-        levelOrderQ.pop();
+    return pivot;
+}
 
-        int currentLevel = p.second;
+/**
+ * Rotates the tree rooted at curr to the right
+ * The caller is responsible for re-attaching the returned root to its parent
+ *
+ * @param TreeNode* curr
+ * @return TreeNode*
+ */
+TreeNode* BinarySearchTree::rotateRight(TreeNode* curr)
+{
+    TreeNode* pivot = curr->left;
 
-        TreeNode* curr = p.first;
+    curr->setLeftChild(pivot->right);
 
-        res[currentLevel].push_back(curr->value);
+    pivot->setRightChild(curr);
 
-        if (curr->left)
-        {
-            levelOrderQ.push(make_pair(curr->left, currentLevel+1));
-        }
+    this->updateNode(curr);
 
-        if (curr->right)
-        {
-            levelOrderQ.push(make_pair(curr->right, currentLevel+1));
-        }
-    }
+    this->updateNode(pivot);
 
-    return res;
+    return pivot;
 }
 
 /**
- * Returns the entire tree in levelOrder
- * Each level is returned as a linked list
+ * Restores the AVL property at curr, if the BST is self balancing
+ * Children of curr are expected to be balanced already
  *
- * @return vector<list<int>>
+ * @param TreeNode* curr
+ * @return TreeNode*
  */
-vector<list<int>> BinarySearchTree::levelOrderLists()
+TreeNode* BinarySearchTree::rebalance(TreeNode* curr)
 {
-    int levels = this->getHeight();
-
-    vector<list<int>> res(levels, list<int>());
+    this->updateNode(curr);
 
-    if (levels == 0) return res;
+    if (this->mode != BalanceMode::AVL) return curr;
 
-    queue<pair<TreeNode*, int>> levelOrderQ;
+    int balance = this->getBalanceFactor(curr);
 
-    levelOrderQ.push(make_pair(this->root, 0));
-
-    while (!levelOrderQ.empty())
+    if (balance > 1)
     {
-        pair<TreeNode*, int> p = levelOrderQ.front();
-
-        levelOrderQ.pop();
-
-        int currentLevel = p.second;
-
-        TreeNode* curr = p.first;
-
-        res[currentLevel].push_back(curr->value);
-
-        if (curr->left)
+        // Left-right case is reduced to the left-left case
+        if (this->getBalanceFactor(curr->left) < 0)
         {
-            levelOrderQ.push(make_pair(curr->left, currentLevel+1));
+            curr->setLeftChild(this->rotateLeft(curr->left));
         }
 
-        if (curr->right)
+        return this->rotateRight(curr);
+    }
+    else if (balance < -1)
+    {
+        // Right-left case is reduced to the right-right case
+        if (this->getBalanceFactor(curr->right) > 0)
         {
-            levelOrderQ.push(make_pair(curr->right, currentLevel+1));
+            curr->setRightChild(this->rotateRight(curr->right));
         }
+
+        return this->rotateLeft(curr);
     }
 
-    return res;
+    return curr;
 }
 
 /**
- * Prints the tree inOrder
+ * Rotates node above its parent, and re-attaches it to its grandparent
  *
+ * @param TreeNode* node
  * @return void
  */
-void BinarySearchTree::printTree()
+void BinarySearchTree::rotateUp(TreeNode* node)
 {
-    vector<int> res = this->inOrder();
+    TreeNode* parent = node->parent;
 
-    for (int val : res)
+    TreeNode* grandparent = parent->parent;
+
+    bool leftOfGrandparent = grandparent && grandparent->left == parent;
+
+    if (parent->left == node)
     {
-        cout << val << " ";
+        parent->setLeftChild(node->right);
+
+        node->setRightChild(parent);
     }
+    else
+    {
+        parent->setRightChild(node->left);
 
-    cout << endl;
+        node->setLeftChild(parent);
+    }
+
+    // node keeps moving up, so only the parent it moved above is final here
+    this->updateCounts(parent);
+
+    if (!grandparent) node->setParent(nullptr);
+    else if (leftOfGrandparent) grandparent->setLeftChild(node);
+    else grandparent->setRightChild(node);
 }
 
 /**
- * Prints the tree in level order
+ * Moves node to the root of its tree by zig, zig-zig and zig-zag steps
+ * Every ancestor of node is rotated on the way, bottom up, so their heights,
+ * Sizes and sums are all recomputed, and node's once it reaches the root
+ * Hashes are only marked stale, they are recomputed before the next read
  *
+ * @param TreeNode* node
  * @return void
  */
-void BinarySearchTree::printLevelOrder()
+void BinarySearchTree::splay(TreeNode* node)
 {
-    vector<vector<int>> res = this->levelOrder();
+    if (node->parent) this->hashesStale = true;
 
-    for (int level=0; level<res.size(); level++)
+    while (node->parent)
     {
-        printf("Printing level %d\n", level);
+        TreeNode* parent = node->parent;
 
-        for (int num : res[level])
+        TreeNode* grandparent = parent->parent;
+
+        if (!grandparent)
         {
-            cout << num << " ";
+            this->rotateUp(node);
+        }
+        else if ((grandparent->left == parent) == (parent->left == node))
+        {
+            // Zig-zig rotates the parent first, which roughly halves the depth of the path
+            this->rotateUp(parent);
+
+            this->rotateUp(node);
         }
+        else
+        {
+            this->rotateUp(node);
 
-        cout << endl;
+            this->rotateUp(node);
+        }
     }
+
+    this->updateCounts(node);
+
+    this->root = node;
 }
 
 /**
- * Returns the height of the tree
+ * Inserts a new node and splays it to the root
+ * Iterative, as a splay tree may be arbitrarily deep between accesses
  *
- * @param TreeNode* curr
- * @return int
+ * @param int val
+ * @return void
  */
-int BinarySearchTree::getHeight(TreeNode* curr)
+void BinarySearchTree::splayInsert(int val)
 {
-    if (!curr) return 0;
+    TreeNode* node = new TreeNode(val);
 
-    curr->setHeight();
+    if (!this->root)
+    {
+        this->root = node;
 
-    return curr->getHeight();
-}
+        return;
+    }
 
-/**
- * Returns the height of the tree
- * Height of the root is 1
- *
- * @return int
- */
-int BinarySearchTree::getHeight()
-{
-    return this->getHeight(this->root);
-}
+    TreeNode* curr = this->root;
 
-/**
- * Returns the root of the bst
- *
- * @return TreeNode*
- */
-TreeNode* BinarySearchTree::getRoot()
-{
-    return this->root;
+    while (true)
+    {
+        TreeNode* next = curr->value >= val ? curr->left : curr->right;
+
+        if (!next) break;
+
+        curr = next;
+    }
+
+    if (curr->value >= val) curr->setLeftChild(node);
+    else curr->setRightChild(node);
+
+    this->splay(node);
 }
 
 /**
- * Returns whether the height of the tree is balanced
+ * Splays one node holding val to the root and removes it
+ * The largest node of the left subtree is splayed to the top of that subtree,
+ * Where it has no right child, and takes the right subtree as its right child
+ * If val isn't found the last node visited is splayed instead
+ * Returns whether a node was removed
  *
- * @param TreeNode* curr
+ * @param int val
  * @return bool
  */
-bool BinarySearchTree::getBalanced(TreeNode* curr)
+bool BinarySearchTree::splayRemove(int val)
 {
-    if (!curr) return true;
+    TreeNode* curr = this->root;
 
-    int left = curr->left ? curr->left->getHeight() : 0;
+    TreeNode* last = nullptr;
 
-    int right = curr->right ? curr->right->getHeight() : 0;
+    while (curr && curr->value != val)
+    {
+        last = curr;
 
-    int diff = abs(left - right);
+        curr = curr->value > val ? curr->left : curr->right;
+    }
 
-    if (diff > 1) return false;
+    if (!curr)
+    {
+        if (last) this->splay(last);
 
-    else if (!this->getBalanced(curr->left)) return false;
+        return false;
+    }
 
-    else if (!this->getBalanced(curr->right)) return false;
+    this->splay(curr);
 
-    return true;
-}
+    TreeNode* left = curr->left;
 
-/**
- * Returns whether the height of the tree is balanced
- *
- * @return bool
- */
-bool BinarySearchTree::getBalanced()
-{
-    return this->getBalanced(this->getRoot());
-}
+    TreeNode* right = curr->right;
 
-/**
- * Clears the binary tree
- *
- * @return void
- */
-void BinarySearchTree::clear()
-{
-    this->root = NULL;
+    this->freeNode(curr);
 
-    this->size = 0;
+    if (right) right->setParent(nullptr);
+
+    if (!left)
+    {
+        this->root = right;
+
+        return true;
+    }
+
+    left->setParent(nullptr);
+
+    TreeNode* largest = left;
+
+    while (largest->right) largest = largest->right;
+
+    this->splay(largest);
+
+    largest->setRightChild(right);
+
+    this->updateNode(largest);
+
+    return true;
 }
 
 /**
- * Gets the nth rank node by in order
+ * Recursively inserts a new node into the Binary Search Tree
  *
  * @param TreeNode* curr
- * @param int& n
+ * @param int val
  * @return TreeNode*
  */
-TreeNode* BinarySearchTree::getNthRank(TreeNode* curr, int& n)
+TreeNode* BinarySearchTree::recursiveInsert(TreeNode* curr, int val)
 {
-    if (!curr) return nullptr;
-
-    TreeNode* left = this->getNthRank(curr->left, n);
+    if (!curr) return new TreeNode(val);
 
-    if (left != nullptr) return left;
+    if (curr->value >= val)
+    {
+        TreeNode* left = recursiveInsert(curr->left, val);
 
-    n--;
+        curr->setLeftChild(left);
+    }
+    else
+    {
+        TreeNode* right = recursiveInsert(curr->right, val);
 
-    if (n == 0) return curr;
+        curr->setRightChild(right);
+    }
 
-    return this->getNthRank(curr->right, n);
+    return this->rebalance(curr);
 }
 
 /**
- * Gets the nth rank node by in order
+ * Inserts a new node into the Binary Search Tree
+ *
+ * @param int val
+ * @return void
+ */
+void BinarySearchTree::insert(int val)
+{
+    this->size++;
+
+    if (this->mode == BalanceMode::SPLAY)
+    {
+        this->splayInsert(val);
+
+        return;
+    }
+
+    this->root = this->recursiveInsert(this->root, val);
+
+    this->root->setParent(nullptr);
+}
+
+/**
+ * Recursively removes one node holding val from the tree rooted at curr
+ * Returns the new root of the tree rooted at curr
+ *
+ * @param TreeNode* curr
+ * @param int val
+ * @param bool& removed
+ * @return TreeNode*
+ */
+TreeNode* BinarySearchTree::recursiveRemove(TreeNode* curr, int val, bool& removed)
+{
+    if (!curr) return curr;
+
+    if (curr->value > val)
+    {
+        curr->setLeftChild(this->recursiveRemove(curr->left, val, removed));
+    }
+    else if (curr->value < val)
+    {
+        curr->setRightChild(this->recursiveRemove(curr->right, val, removed));
+    }
+    else
+    {
+        removed = true;
+
+        if (!curr->left || !curr->right)
+        {
+            TreeNode* child = curr->left ? curr->left : curr->right;
+
+            this->freeNode(curr);
+
+            return child;
+        }
+
+        // Two children, so curr takes over the value of its in order successor
+        TreeNode* successor = curr->right;
+
+        while (successor->left) successor = successor->left;
+
+        curr->value = successor->value;
+
+        bool removedSuccessor = false;
+
+        curr->setRightChild(this->recursiveRemove(curr->right, successor->value, removedSuccessor));
+    }
+
+    return this->rebalance(curr);
+}
+
+/**
+ * Removes one node holding val from the Binary Search Tree
+ * Returns whether a node was removed
+ *
+ * @param int val
+ * @return bool
+ */
+bool BinarySearchTree::remove(int val)
+{
+    bool removed = false;
+
+    if (this->mode == BalanceMode::SPLAY)
+    {
+        removed = this->splayRemove(val);
+    }
+    else
+    {
+        this->root = this->recursiveRemove(this->root, val, removed);
+
+        if (this->root) this->root->setParent(nullptr);
+    }
+
+    if (removed) this->size--;
+
+    this->subtreeIndexStale = true;
+
+    return removed;
+}
+
+/**
+ * Frees a node that was unlinked from the tree
+ * Pooled nodes stay allocated, as the pool is one allocation
+ *
+ * @param TreeNode* node
+ * @return void
+ */
+void BinarySearchTree::freeNode(TreeNode* node)
+{
+    if (node->unbalanced) this->unbalancedNodes--;
+
+    if (node->pooled) return;
+
+    delete node;
+}
+
+/**
+ * Allocates an uninitialized pool of n nodes, held by the tree
+ * The pool is one allocation, freed as a whole once the last tree holding it drops it
+ *
+ * @param int n
+ * @return TreeNode*
+ */
+TreeNode* BinarySearchTree::allocatePool(int n)
+{
+    TreeNode* pool = static_cast<TreeNode*>(::operator new(sizeof(TreeNode) * n));
+
+    this->pools.push_back(shared_ptr<TreeNode>(pool, [](TreeNode* p) { ::operator delete(p); }));
+
+    return pool;
+}
+
+/**
+ * Builds a balanced tree of sorted[lo..hi] into pool in pre order
+ * The left subtree takes the slots right after the root, then the right subtree
+ *
+ * @param TreeNode* pool
+ * @param const int* sorted
+ * @param int lo
+ * @param int hi
+ * @param int forkDepth
+ * @return TreeNode*
+ */
+TreeNode* BinarySearchTree::buildBalanced(TreeNode* pool, const int* sorted, int lo, int hi, int forkDepth)
+{
+    if (lo > hi) return nullptr;
+
+    int mid = lo + (hi - lo) / 2;
+
+    TreeNode* curr = new (pool) TreeNode(sorted[mid]);
+
+    curr->pooled = true;
+
+    TreeNode* left = nullptr;
+
+    TreeNode* right = nullptr;
+
+    if (forkDepth > 0 && hi - lo >= BULK_LOAD_GRAIN)
+    {
+        // Both halves write to disjoint slots of the pool
+        thread worker([&]() {
+            left = buildBalanced(pool + 1, sorted, lo, mid-1, forkDepth-1);
+        });
+
+        right = buildBalanced(pool + 1 + (mid - lo), sorted, mid+1, hi, forkDepth-1);
+
+        worker.join();
+    }
+    else
+    {
+        left = buildBalanced(pool + 1, sorted, lo, mid-1, 0);
+
+        right = buildBalanced(pool + 1 + (mid - lo), sorted, mid+1, hi, 0);
+    }
+
+    curr->setLeftChild(left);
+
+    curr->setRightChild(right);
+
+    curr->setHeight();
+
+    curr->setSize();
+
+    curr->setSum();
+
+    curr->setHash();
+
+    return curr;
+}
+
+/**
+ * Replaces the contents of the tree with n values sorted in increasing order
+ * Builds a balanced tree in O(n), without any comparisons
+ *
+ * @param const int* sorted
+ * @param int n
+ * @return void
+ */
+void BinarySearchTree::bulkLoad(const int* sorted, int n)
+{
+    this->clear();
+
+    if (n <= 0) return;
+
+    TreeNode* pool = this->allocatePool(n);
+
+    // One level of forking doubles the number of threads
+    int forkDepth = 0;
+
+    while ((2 << forkDepth) <= (int) thread::hardware_concurrency()) forkDepth++;
+
+    this->root = buildBalanced(pool, sorted, 0, n-1, forkDepth);
+
+    this->root->setParent(nullptr);
+
+    this->size = n;
+}
+
+/**
+ * Replaces the contents of the tree with values sorted in increasing order
+ *
+ * @param vector<int>& sorted
+ * @return void
+ */
+void BinarySearchTree::bulkLoad(vector<int>& sorted)
+{
+    this->bulkLoad(sorted.data(), sorted.size());
+}
+
+/**
+ * Replaces the contents of the tree with n values in the given shape, in O(n)
+ * shape holds 2n bits, 1 for '(' and 0 for ')', and a node is written ( left ) right
+ * values hold the n values in order, one per ')'
+ * Throws if the shape is not balanced parentheses, the values are not sorted,
+ * Or the tree is AVL and the shape breaks the AVL property, and leaves the tree empty
+ *
+ * @param const uint64_t* shape
+ * @param const int* values
+ * @param int n
+ * @return void
+ */
+void BinarySearchTree::loadShape(const uint64_t* shape, const int* values, int n)
+{
+    this->clear();
+
+    if (n <= 0) return;
+
+    // Checked before the pool is filled, as one '(' too many would write past it
+    long long depth = 0;
+
+    for (size_t i=0; i<(size_t) 2*n && depth >= 0; i++) depth += ((shape[i >> 6] >> (i & 63)) & 1) ? 1 : -1;
+
+    if (depth != 0) throw "Shape is not balanced parentheses";
+
+    for (int i=1; i<n; i++)
+    {
+        if (values[i] < values[i-1]) throw "Shape values are not sorted";
+    }
+
+    TreeNode* pool = this->allocatePool(n);
+
+    // Nodes are placed in pre order, the order of their '('
+    vector<TreeNode*> open;
+
+    TreeNode* closed = nullptr;
+
+    int created = 0, k = 0;
+
+    for (size_t i=0; i<(size_t) 2*n; i++)
+    {
+        if ((shape[i >> 6] >> (i & 63)) & 1)
+        {
+            TreeNode* node = new (pool + created++) TreeNode(0);
+
+            node->pooled = true;
+
+            // After a '(' comes the left child, after a ')' the right child
+            if (closed) closed->setRightChild(node);
+            else if (!open.empty()) open.back()->setLeftChild(node);
+
+            open.push_back(node);
+
+            closed = nullptr;
+        }
+        else
+        {
+            closed = open.back();
+
+            open.pop_back();
+
+            closed->value = values[k++];
+        }
+    }
+
+    // Children come after their parent in pre order
+    for (int i=n-1; i>=0; i--) this->updateNode(pool + i);
+
+    this->root = pool;
+
+    this->root->setParent(nullptr);
+
+    this->size = n;
+
+    if (this->mode == BalanceMode::AVL && this->unbalancedNodes > 0)
+    {
+        this->clear();
+
+        throw "Shape is not an AVL tree";
+    }
+}
+
+/**
+ * Appends the nodes of the tree rooted at curr to res in order
+ * Explicit stack, as an unbalanced tree may be arbitrarily deep
+ *
+ * @param TreeNode* curr
+ * @param vector<TreeNode*>& res
+ * @return void
+ */
+void BinarySearchTree::collectNodes(TreeNode* curr, vector<TreeNode*>& res)
+{
+    vector<TreeNode*> stack;
+
+    while (curr || !stack.empty())
+    {
+        while (curr)
+        {
+            stack.push_back(curr);
+
+            curr = curr->left;
+        }
+
+        curr = stack.back();
+
+        stack.pop_back();
+
+        res.push_back(curr);
+
+        curr = curr->right;
+    }
+}
+
+/**
+ * Links nodes[lo..hi], which are sorted, into a balanced tree and returns its root
+ * Children are linked before their parent, so updateNode sees them complete
+ *
+ * @param vector<TreeNode*>& nodes
+ * @param int lo
+ * @param int hi
+ * @return TreeNode*
+ */
+TreeNode* BinarySearchTree::linkBalanced(vector<TreeNode*>& nodes, int lo, int hi)
+{
+    if (lo > hi) return nullptr;
+
+    int mid = lo + (hi - lo) / 2;
+
+    TreeNode* curr = nodes[mid];
+
+    curr->setLeftChild(this->linkBalanced(nodes, lo, mid-1));
+
+    curr->setRightChild(this->linkBalanced(nodes, mid+1, hi));
+
+    this->updateNode(curr);
+
+    return curr;
+}
+
+/**
+ * Replaces the contents of the tree with the sorted nodes, relinked balanced
+ * The nodes are reused as they are, so nothing is allocated or copied
+ *
+ * @param vector<TreeNode*>& nodes
+ * @return void
+ */
+void BinarySearchTree::relink(vector<TreeNode*>& nodes)
+{
+    // Flags may have been counted by another tree, a balanced tree has none
+    for (TreeNode* node : nodes) node->unbalanced = false;
+
+    this->unbalancedNodes = 0;
+
+    this->root = this->linkBalanced(nodes, 0, (int) nodes.size() - 1);
+
+    if (this->root) this->root->setParent(nullptr);
+
+    this->size = nodes.size();
+
+    this->subtreeIndexStale = true;
+}
+
+/**
+ * Moves every node of other into the tree, in O(n + m), and empties other
+ * Both trees are read in order, merged like merge sort and relinked balanced
+ *
+ * @param BinarySearchTree& other
+ * @return void
+ */
+void BinarySearchTree::merge(BinarySearchTree& other)
+{
+    if (&other == this) return;
+
+    vector<TreeNode*> mine, theirs;
+
+    mine.reserve(this->size);
+
+    theirs.reserve(other.size);
+
+    collectNodes(this->root, mine);
+
+    collectNodes(other.root, theirs);
+
+    vector<TreeNode*> nodes(mine.size() + theirs.size());
+
+    std::merge(mine.begin(), mine.end(), theirs.begin(), theirs.end(), nodes.begin(), [](TreeNode* a, TreeNode* b) {
+        return a->value < b->value;
+    });
+
+    this->relink(nodes);
+
+    // Pooled nodes of other now live here, so freeNode must still recognize them
+    this->pools.insert(this->pools.end(), other.pools.begin(), other.pools.end());
+
+    other.pools.clear();
+
+    other.clear();
+}
+
+/**
+ * Moves every node holding a value greater than key into a new tree, in O(n)
+ * Returns the new tree, the values up to key stay
+ *
+ * @param int key
+ * @return BinarySearchTree
+ */
+BinarySearchTree BinarySearchTree::split(int key)
+{
+    vector<TreeNode*> nodes;
+
+    nodes.reserve(this->size);
+
+    collectNodes(this->root, nodes);
+
+    int cut = upper_bound(nodes.begin(), nodes.end(), key, [](int val, TreeNode* node) {
+        return val < node->value;
+    }) - nodes.begin();
+
+    vector<TreeNode*> upper(nodes.begin() + cut, nodes.end());
+
+    nodes.resize(cut);
+
+    BinarySearchTree res = BinarySearchTree(this->mode);
+
+    // Either tree may hold pooled nodes, so both hold every pool
+    res.pools = this->pools;
+
+    res.relink(upper);
+
+    this->relink(nodes);
+
+    return res;
+}
+
+/**
+ * Removes every node holding a value in [lo, hi], in O(n)
+ * Returns the number of nodes removed
+ *
+ * @param int lo
+ * @param int hi
+ * @return int
+ */
+int BinarySearchTree::eraseRange(int lo, int hi)
+{
+    vector<TreeNode*> nodes;
+
+    nodes.reserve(this->size);
+
+    collectNodes(this->root, nodes);
+
+    int kept = 0;
+
+    for (TreeNode* node : nodes)
+    {
+        if (node->value < lo || node->value > hi) nodes[kept++] = node;
+        else this->freeNode(node);
+    }
+
+    int removed = nodes.size() - kept;
+
+    if (!removed) return 0;
+
+    nodes.resize(kept);
+
+    this->relink(nodes);
+
+    return removed;
+}
+
+/**
+ * Finds the TreeNode* that contains val, if exists
+ *
+ * @param TreeNode* curr
+ * @param int val
+ * @return TreeNode*
+ */
+TreeNode* BinarySearchTree::find(TreeNode* curr, int val)
+{
+    while (curr && curr->value != val)
+    {
+        curr = curr->value > val ? curr->left : curr->right;
+    }
+
+    return curr;
+}
+
+/**
+ * Checks whether a value exists in the BST
+ * In SPLAY mode the node found, or the last node visited, moves to the root
+ *
+ * @param int val
+ * @return bool
+ */
+bool BinarySearchTree::exists(int val)
+{
+    if (this->mode == BalanceMode::SPLAY)
+    {
+        TreeNode* curr = this->root;
+
+        TreeNode* last = nullptr;
+
+        while (curr && curr->value != val)
+        {
+            last = curr;
+
+            curr = curr->value > val ? curr->left : curr->right;
+        }
+
+        // A miss splays the last node on the path, so repeated misses get cheap too
+        if (curr) this->splay(curr);
+        else if (last) this->splay(last);
+
+        return curr != NULL;
+    }
+
+    TreeNode* curr = this->find(this->root, val);
+
+    return curr != NULL;
+}
+
+/**
+ * Returns the number of vertices in the BST
+ *
+ * @return int
+ */
+int BinarySearchTree::getNumVertices()
+{
+    return this->size;
+}
+
+/**
+ * Returns the entire tree inOrder
+ *
+ * @param TreeNode* curr
+ * @param vector<int>& res
+ * @return void
+ */
+void BinarySearchTree::inOrder(TreeNode* curr, vector<int>& res)
+{
+    InOrderIterator it = InOrderIterator(curr);
+
+    while (it.hasNext()) res.push_back(it.next());
+}
+
+/**
+ * Returns the entire tree inOrder
+ *
+ * @return vector<int>
+ */
+vector<int> BinarySearchTree::inOrder()
+{
+    vector<int> res;
+
+    res.reserve(this->size);
+
+    this->inOrder(this->root, res);
+
+    return res;
+}
+
+/**
+ * Returns an immutable snapshot of the tree in Eytzinger layout
+ * Later changes to the tree are not reflected in the snapshot
+ *
+ * @return EytzingerTree
+ */
+EytzingerTree BinarySearchTree::freeze()
+{
+    vector<int> sorted = this->inOrder();
+
+    return EytzingerTree(sorted);
+}
+
+/**
+ * Returns an iterator over the tree in order
+ *
+ * @return InOrderIterator
+ */
+InOrderIterator BinarySearchTree::inOrderIterator()
+{
+    return InOrderIterator(this->root);
+}
+
+/**
+ * Returns an iterator over the tree in pre order
+ *
+ * @return PreOrderIterator
+ */
+PreOrderIterator BinarySearchTree::preOrderIterator()
+{
+    return PreOrderIterator(this->root);
+}
+
+/**
+ * Returns an iterator over the tree in level order
+ *
+ * @return LevelOrderIterator
+ */
+LevelOrderIterator BinarySearchTree::levelOrderIterator()
+{
+    return LevelOrderIterator(this->root);
+}
+
+/**
+ * Fills flat buffers with the entire tree in level order, in O(n)
+ * Level i is held in values[levelStarts[i], levelStarts[i+1])
+ * The value buffers are reused, the queue of nodes is the only allocation
+ *
+ * @param vector<int>& values
+ * @param vector<int>& levelStarts
+ * @return void
+ */
+void BinarySearchTree::levelOrder(vector<int>& values, vector<int>& levelStarts)
+{
+    values.clear();
+
+    levelStarts.clear();
+
+    // The nodes of the queue are in the same order as their values
+    vector<TreeNode*> queue;
+
+    queue.reserve(this->size);
+
+    if (this->root) queue.push_back(this->root);
+
+    size_t head = 0;
+
+    while (head < queue.size())
+    {
+        levelStarts.push_back(head);
+
+        // Every node queued so far is on the current level, their children are on the next
+        size_t levelEnd = queue.size();
+
+        for (; head<levelEnd; head++)
+        {
+            TreeNode* curr = queue[head];
+
+            values.push_back(curr->value);
+
+            if (curr->left) queue.push_back(curr->left);
+
+            if (curr->right) queue.push_back(curr->right);
+        }
+    }
+
+    levelStarts.push_back(head);
+}
+
+/**
+ * Returns the entire tree levelOrder
+ *
+ * @return vector<vector<int>>
+ */
+vector<vector<int>> BinarySearchTree::levelOrder()
+{
+    vector<int> values, levelStarts;
+
+    this->levelOrder(values, levelStarts);
+
+    vector<vector<int>> res(levelStarts.size() - 1);
+
+    for (size_t level=0; level<res.size(); level++)
+    {
+        res[level].assign(values.begin() + levelStarts[level], values.begin() + levelStarts[level+1]);
+    }
+
+    return res;
+}
+
+/**
+ * Returns the entire tree in levelOrder
+ * Each level is returned as a linked list
+ *
+ * @return vector<list<int>>
+ */
+vector<list<int>> BinarySearchTree::levelOrderLists()
+{
+    vector<int> values, levelStarts;
+
+    this->levelOrder(values, levelStarts);
+
+    vector<list<int>> res(levelStarts.size() - 1);
+
+    for (size_t level=0; level<res.size(); level++)
+    {
+        res[level].assign(values.begin() + levelStarts[level], values.begin() + levelStarts[level+1]);
+    }
+
+    return res;
+}
+
+/**
+ * Prints the tree inOrder
+ *
+ * @return void
+ */
+void BinarySearchTree::printTree()
+{
+    vector<int> res = this->inOrder();
+
+    for (int val : res)
+    {
+        cout << val << " ";
+    }
+
+    cout << endl;
+}
+
+/**
+ * Prints the tree in level order
+ *
+ * @return void
+ */
+void BinarySearchTree::printLevelOrder()
+{
+    vector<vector<int>> res = this->levelOrder();
+
+    for (int level=0; level<res.size(); level++)
+    {
+        printf("Printing level %d\n", level);
+
+        for (int num : res[level])
+        {
+            cout << num << " ";
+        }
+
+        cout << endl;
+    }
+}
+
+/**
+ * Returns the height of the tree rooted at curr, in O(1)
+ * Heights are kept up to date on every insert, remove and rotation
+ *
+ * @param TreeNode* curr
+ * @return int
+ */
+int BinarySearchTree::getHeight(TreeNode* curr)
+{
+    return curr ? curr->getHeight() : 0;
+}
+
+/**
+ * Returns the height of the tree, in O(1)
+ * Height of the root is 1
+ *
+ * @return int
+ */
+int BinarySearchTree::getHeight()
+{
+    return this->getHeight(this->root);
+}
+
+/**
+ * Returns the root of the bst
+ *
+ * @return TreeNode*
+ */
+TreeNode* BinarySearchTree::getRoot()
+{
+    return this->root;
+}
+
+/**
+ * Returns whether the height of the tree rooted at curr is balanced
+ * O(1) for the root, O(size of the tree) for any other node
+ *
+ * @param TreeNode* curr
+ * @return bool
+ */
+bool BinarySearchTree::getBalanced(TreeNode* curr)
+{
+    if (curr == this->root) return this->unbalancedNodes == 0;
+
+    PreOrderIterator it = PreOrderIterator(curr);
+
+    while (it.hasNext())
+    {
+        if (it.nextNode()->unbalanced) return false;
+    }
+
+    return true;
+}
+
+/**
+ * Returns whether the height of the tree is balanced, in O(1)
+ *
+ * @return bool
+ */
+bool BinarySearchTree::getBalanced()
+{
+    return this->unbalancedNodes == 0;
+}
+
+/**
+ * Checks in one O(n) pass that every stored height, size, balance flag
+ * And parent pointer matches the children, and that the counts match the tree
+ * Each node is checked against its children only, which by induction from the
+ * Leaves covers every stored value
+ *
+ * @return bool
+ */
+bool BinarySearchTree::audit()
+{
+    int nodes = 0, unbalanced = 0;
+
+    // Explicit stack rather than an iterator, as parent pointers are under audit
+    vector<TreeNode*> stack;
+
+    if (this->root)
+    {
+        if (this->root->parent) return false;
+
+        stack.push_back(this->root);
+    }
+
+    while (!stack.empty())
+    {
+        TreeNode* curr = stack.back();
+
+        stack.pop_back();
+
+        int heightL = curr->left ? curr->left->height : 0;
+
+        int heightR = curr->right ? curr->right->height : 0;
+
+        int sizeL = curr->left ? curr->left->size : 0;
+
+        int sizeR = curr->right ? curr->right->size : 0;
+
+        if (curr->height != 1 + max(heightL, heightR)) return false;
+
+        if (curr->size != 1 + sizeL + sizeR) return false;
+
+        if (curr->unbalanced != (abs(heightL - heightR) > 1)) return false;
+
+        nodes++;
+
+        unbalanced += curr->unbalanced;
+
+        if (curr->left)
+        {
+            if (curr->left->parent != curr) return false;
+
+            stack.push_back(curr->left);
+        }
+
+        if (curr->right)
+        {
+            if (curr->right->parent != curr) return false;
+
+            stack.push_back(curr->right);
+        }
+    }
+
+    return nodes == this->size && unbalanced == this->unbalancedNodes;
+}
+
+/**
+ * Clears the binary tree
+ *
+ * @return void
+ */
+void BinarySearchTree::clear()
+{
+    this->root = NULL;
+
+    this->size = 0;
+
+    this->unbalancedNodes = 0;
+
+    // Pools still shared with a split tree stay allocated until that tree drops them too
+    this->pools.clear();
+
+    this->subtreeIndex.clear();
+
+    this->subtreeIndexStale = true;
+}
+
+/**
+ * Gets the nth rank node by in order in the tree rooted at curr
+ * Subtree sizes let us skip the whole left subtree in one step
+ *
+ * @param TreeNode* curr
+ * @param int& n
+ * @return TreeNode*
+ */
+TreeNode* BinarySearchTree::getNthRank(TreeNode* curr, int& n)
+{
+    while (curr)
+    {
+        int leftSize = curr->left ? curr->left->getSize() : 0;
+
+        if (n <= leftSize)
+        {
+            curr = curr->left;
+        }
+        else if (n == leftSize + 1)
+        {
+            n = 0;
+
+            return curr;
+        }
+        else
+        {
+            n -= leftSize + 1;
+
+            curr = curr->right;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * Gets the nth rank node by in order in O(height)
  * n must be in the range [1, numVertices]
  *
  * @param int n
@@ -378,8 +1438,111 @@ TreeNode* BinarySearchTree::getNthRank(int n)
     return this->getNthRank(this->getRoot(), n);
 }
 
+/**
+ * Returns the number of values less than val
+ * If inclusive, values equal to val are counted as well
+ *
+ * @param int val
+ * @param bool inclusive
+ * @return int
+ */
+int BinarySearchTree::countBelow(int val, bool inclusive)
+{
+    int count = 0;
+
+    TreeNode* curr = this->getRoot();
+
+    while (curr)
+    {
+        if (curr->value < val || (inclusive && curr->value == val))
+        {
+            count += 1 + (curr->left ? curr->left->getSize() : 0);
+
+            curr = curr->right;
+        }
+        else
+        {
+            curr = curr->left;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Returns the sum of the values less than val
+ * If inclusive, values equal to val are summed as well
+ *
+ * @param int val
+ * @param bool inclusive
+ * @return long long
+ */
+long long BinarySearchTree::sumBelow(int val, bool inclusive)
+{
+    long long sum = 0;
+
+    TreeNode* curr = this->getRoot();
+
+    while (curr)
+    {
+        if (curr->value < val || (inclusive && curr->value == val))
+        {
+            sum += curr->value + (curr->left ? curr->left->getSum() : 0);
+
+            curr = curr->right;
+        }
+        else
+        {
+            curr = curr->left;
+        }
+    }
+
+    return sum;
+}
+
+/**
+ * Returns the rank of the first occurrence of val by in order
+ * If val doesn't exist, returns the rank it would have once inserted
+ *
+ * @param int val
+ * @return int
+ */
+int BinarySearchTree::rankOf(int val)
+{
+    return this->countBelow(val, false) + 1;
+}
+
+/**
+ * Returns the number of values in the range [lo, hi]
+ *
+ * @param int lo
+ * @param int hi
+ * @return int
+ */
+int BinarySearchTree::rangeCount(int lo, int hi)
+{
+    if (lo > hi) return 0;
+
+    return this->countBelow(hi, true) - this->countBelow(lo, false);
+}
+
+/**
+ * Returns the sum of the values in the range [lo, hi]
+ *
+ * @param int lo
+ * @param int hi
+ * @return long long
+ */
+long long BinarySearchTree::rangeSum(int lo, int hi)
+{
+    if (lo > hi) return 0;
+
+    return this->sumBelow(hi, true) - this->sumBelow(lo, false);
+}
+
 /**
  * Generates the pre order string of root
+ * Missing children are written as #, and the walk follows parent pointers
  *
  * @param TreeNode* root
  * @param string& res
@@ -387,15 +1550,66 @@ TreeNode* BinarySearchTree::getNthRank(int n)
  */
 void BinarySearchTree::generatePreOrderString(TreeNode* root, string& res)
 {
-    if (!root) res.push_back('#');
+    if (!root)
+    {
+        res.push_back('#');
 
-    else
+        return;
+    }
+
+    TreeNode* curr = root;
+
+    TreeNode* prev = nullptr;
+
+    bool down = true;
+
+    while (true)
     {
-        res += to_string(root->getValue());
+        if (down)
+        {
+            // First visit of curr
+            res += to_string(curr->getValue());
+
+            if (curr->left)
+            {
+                curr = curr->left;
+
+                continue;
+            }
+
+            res.push_back('#');
+
+            if (curr->right)
+            {
+                curr = curr->right;
+
+                continue;
+            }
+
+            res.push_back('#');
+        }
+        else if (prev == curr->left)
+        {
+            // Back from the left subtree, so the right subtree is next
+            if (curr->right)
+            {
+                curr = curr->right;
+
+                down = true;
+
+                continue;
+            }
 
-        this->generatePreOrderString(root->left, res);
+            res.push_back('#');
+        }
+
+        if (curr == root) return;
+
+        prev = curr;
+
+        curr = curr->parent;
 
-        this->generatePreOrderString(root->right, res);
+        down = false;
     }
 }
 
@@ -414,51 +1628,193 @@ string BinarySearchTree::getPreOrderString(TreeNode* root)
     return res;
 }
 
+/**
+ * Rebuilds the subtree index from the stored structural hashes
+ *
+ * @return void
+ */
+void BinarySearchTree::buildSubtreeIndex()
+{
+    this->refreshHashes();
+
+    this->subtreeIndex.clear();
+
+    this->subtreeIndex.reserve(this->size);
+
+    PreOrderIterator it = PreOrderIterator(this->root);
+
+    while (it.hasNext())
+    {
+        TreeNode* node = it.nextNode();
+
+        this->subtreeIndex.emplace(node->getHash(), node);
+    }
+
+    this->subtreeIndexStale = false;
+}
+
+/**
+ * Returns whether both trees have the same shape and values
+ * Both trees are walked in pre order side by side
+ *
+ * @param TreeNode* tree1
+ * @param TreeNode* tree2
+ * @return bool
+ */
+bool BinarySearchTree::isSameTree(TreeNode* tree1, TreeNode* tree2)
+{
+    PreOrderIterator it1 = PreOrderIterator(tree1);
+
+    PreOrderIterator it2 = PreOrderIterator(tree2);
+
+    while (it1.hasNext() && it2.hasNext())
+    {
+        TreeNode* node1 = it1.nextNode();
+
+        TreeNode* node2 = it2.nextNode();
+
+        if (node1->value != node2->value) return false;
+
+        else if (!node1->left != !node2->left) return false;
+
+        else if (!node1->right != !node2->right) return false;
+    }
+
+    return it1.hasNext() == it2.hasNext();
+}
+
 /**
  * Returns whether input tree is a subtree of this tree
+ * Candidates are found by structural hash, and then verified
+ * The hash of tree2 is computed aside, in O(size of tree2), as a tree built by hand
+ * Through setLeftChild and setRightChild never updates its stored hashes
  *
  * @param TreeNode* tree2
  * @return bool
  */
 bool BinarySearchTree::isSubtree(TreeNode* tree2)
 {
-    string s1 = this->getPreOrderString(tree2);
+    if (!tree2) return true;
 
-    string s2 = this->getPreOrderString(this->getRoot());
+    if (this->subtreeIndexStale) this->buildSubtreeIndex();
+
+    auto range = this->subtreeIndex.equal_range(hashOf(tree2));
+
+    for (auto it = range.first; it != range.second; it++)
+    {
+        if (isSameTree(it->second, tree2)) return true;
+    }
 
-    return s2.find(s1) != string::npos;
+    return false;
 }
 
 /**
- * Returns the number of paths that sum to k
+ * Returns the groups of identical subtrees found across the forest
+ * Only subtrees of at least minSize nodes are reported
  *
- * @param unordered_map<int, int>& hash
- * @param TreeNode* root
- * @param int k
- * @param int sum
- * @return int
+ * @param vector<BinarySearchTree*>& forest
+ * @param int minSize
+ * @return vector<vector<TreeNode*>>
  */
-int BinarySearchTree::numPaths(unordered_map<int, int>& hash, TreeNode* root, int k, int sum)
+vector<vector<TreeNode*>> BinarySearchTree::findDuplicateSubtrees(vector<BinarySearchTree*>& forest, int minSize)
 {
-    if (!root) return 0;
+    // Group by hash first, then split each bucket into verified groups
+    unordered_map<unsigned long long, vector<TreeNode*>> buckets;
+
+    for (BinarySearchTree* bst : forest)
+    {
+        bst->refreshHashes();
+
+        PreOrderIterator it = bst->preOrderIterator();
+
+        while (it.hasNext())
+        {
+            TreeNode* node = it.nextNode();
+
+            if (node->getSize() >= minSize) buckets[node->getHash()].push_back(node);
+        }
+    }
 
-    sum += root->getValue();
+    vector<vector<TreeNode*>> res;
 
-    int target = sum - k;
+    for (auto& bucket : buckets)
+    {
+        if (bucket.second.size() < 2) continue;
 
-    unordered_map<int, int>::iterator it = hash.find(target);
+        vector<vector<TreeNode*>> groups;
 
-    int count = it != hash.end() ? it->second : 0;
+        for (TreeNode* node : bucket.second)
+        {
+            bool placed = false;
 
-    hash[sum]++;
+            for (vector<TreeNode*>& group : groups)
+            {
+                if (!isSameTree(group[0], node)) continue;
 
-    count += this->numPaths(hash, root->left, k, sum);
+                group.push_back(node);
 
-    count += this->numPaths(hash, root->right, k, sum);
+                placed = true;
 
-    hash[sum]--;
+                break;
+            }
 
-    return count;
+            if (!placed) groups.push_back({node});
+        }
+
+        for (vector<TreeNode*>& group : groups)
+        {
+            if (group.size() > 1) res.push_back(group);
+        }
+    }
+
+    return res;
+}
+
+/**
+ * Adds to counts[i] the number of downward paths summing to ks[i] that end in
+ * The tree rooted at start, with an explicit stack
+ * table holds the prefix sums of the path above start, sum is the last of them
+ *
+ * @param TreeNode* start
+ * @param long long sum
+ * @param PrefixSumTable& table
+ * @param vector<int>& ks
+ * @param vector<long long>& counts
+ * @return void
+ */
+void BinarySearchTree::numPaths(TreeNode* start, long long sum, PrefixSumTable& table, vector<int>& ks, vector<long long>& counts)
+{
+    // (node, prefix sum above it) enters a node, (nullptr, prefix sum) leaves one
+    vector<pair<TreeNode*, long long>> stack;
+
+    if (start) stack.push_back(make_pair(start, sum));
+
+    while (!stack.empty())
+    {
+        pair<TreeNode*, long long> p = stack.back();
+
+        stack.pop_back();
+
+        if (!p.first)
+        {
+            table.remove(p.second);
+
+            continue;
+        }
+
+        long long curr = p.second + p.first->value;
+
+        // A path ending here sums to k when it starts right after a prefix sum of curr - k
+        for (size_t i=0; i<ks.size(); i++) counts[i] += table.count(curr - ks[i]);
+
+        table.add(curr);
+
+        stack.push_back(make_pair(nullptr, curr));
+
+        if (p.first->right) stack.push_back(make_pair(p.first->right, curr));
+
+        if (p.first->left) stack.push_back(make_pair(p.first->left, curr));
+    }
 }
 
 /**
@@ -469,11 +1825,106 @@ int BinarySearchTree::numPaths(unordered_map<int, int>& hash, TreeNode* root, in
  */
 int BinarySearchTree::numPaths(int k)
 {
-    unordered_map<int, int> hash;
+    vector<int> ks(1, k);
+
+    return this->numPaths(ks)[0];
+}
+
+/**
+ * Returns the number of paths that sum to each of ks, in one traversal
+ *
+ * @param vector<int>& ks
+ * @return vector<long long>
+ */
+vector<long long> BinarySearchTree::numPaths(vector<int>& ks)
+{
+    vector<long long> counts(ks.size(), 0);
+
+    PrefixSumTable table = PrefixSumTable();
+
+    table.add(0);
+
+    numPaths(this->root, 0, table, ks, counts);
+
+    return counts;
+}
+
+/**
+ * Returns the number of paths that sum to each of ks, on numThreads threads
+ * Paths ending above the frontier are counted here from the prefix sums of
+ * Their root path, each frontier subtree then starts from a table of the
+ * Prefix sums above it, and the per thread counts are added up at the end
+ *
+ * @param vector<int>& ks
+ * @param int numThreads
+ * @return vector<long long>
+ */
+vector<long long> BinarySearchTree::numPaths(vector<int>& ks, int numThreads)
+{
+    vector<long long> counts(ks.size(), 0);
+
+    if (numThreads <= 1 || !this->root) return this->numPaths(ks);
+
+    // Every frontier node with the prefix sums from the root down to it, starting at 0
+    vector<pair<TreeNode*, vector<long long>>> frontier;
+
+    frontier.push_back(make_pair(this->root, vector<long long>(1, 0)));
+
+    for (int depth=0; depth<PATHS_MAX_SPLIT_DEPTH && frontier.size() < 4 * (size_t) numThreads; depth++)
+    {
+        vector<pair<TreeNode*, vector<long long>>> next;
+
+        for (pair<TreeNode*, vector<long long>>& p : frontier)
+        {
+            vector<long long> sums = p.second;
+
+            long long curr = sums.back() + p.first->value;
+
+            for (size_t i=0; i<ks.size(); i++)
+            {
+                for (long long prefix : sums) counts[i] += curr - prefix == ks[i];
+            }
+
+            sums.push_back(curr);
+
+            if (p.first->left) next.push_back(make_pair(p.first->left, sums));
 
-    hash[0] = 1;
+            if (p.first->right) next.push_back(make_pair(p.first->right, sums));
+        }
+
+        frontier = next;
+
+        if (frontier.empty()) return counts;
+    }
+
+    vector<vector<long long>> threadCounts(numThreads, vector<long long>(ks.size(), 0));
+
+    atomic<int> nextTask(0);
+
+    vector<thread> threads;
+
+    for (int t=0; t<numThreads; t++)
+    {
+        threads.push_back(thread([&frontier, &ks, &threadCounts, &nextTask, t]() {
+            PrefixSumTable table = PrefixSumTable();
+
+            for (int task = nextTask++; task < (int) frontier.size(); task = nextTask++)
+            {
+                table.clear();
+
+                for (long long prefix : frontier[task].second) table.add(prefix);
+
+                numPaths(frontier[task].first, frontier[task].second.back(), table, ks, threadCounts[t]);
+            }
+        }));
+    }
+
+    for (thread& t : threads) t.join();
 
-    TreeNode* start = this->getRoot();
+    for (vector<long long>& c : threadCounts)
+    {
+        for (size_t i=0; i<ks.size(); i++) counts[i] += c[i];
+    }
 
-    return this->numPaths(hash, start, k, 0);
+    return counts;
 }
@@ -2,13 +2,40 @@
 #define BINARY_SEARCH_TREE
 
 #include "tree-node.cpp"
+#include "eytzinger-tree.cpp"
+#include "tree-iterator.cpp"
+#include "prefix-sum-table.cpp"
 #include <vector>
 #include <list>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <cstdint>
+#include <memory>
 
 using namespace std;
 
+/**
+ * Ranges smaller than this are never built on a separate thread by bulkLoad
+ */
+const int BULK_LOAD_GRAIN = 1 << 15;
+
+/**
+ * Deepest level at which the parallel numPaths splits the tree into tasks
+ */
+const int PATHS_MAX_SPLIT_DEPTH = 16;
+
+/**
+ * Balancing strategy applied by the BST on insert and remove
+ * NONE keeps the classic unbalanced BST behaviour
+ * AVL keeps |height(left) - height(right)| <= 1 at every node
+ * SPLAY moves every node inserted, looked up by exists or removed to the root,
+ * So frequently accessed values stay near the top, in O(log n) amortized
+ * Every exists rewrites the path it walked, so it is a write and measures slower
+ * Than NONE and AVL in splay-benchmark, unless the lookups are very skewed
+ */
+enum class BalanceMode { NONE, AVL, SPLAY };
+
 class BinarySearchTree
 {
     private:
@@ -19,6 +46,52 @@ class BinarySearchTree
          */
         int size;
 
+        /**
+         * Balancing strategy of the BST
+         *
+         * @param BalanceMode mode
+         */
+        BalanceMode mode;
+
+        /**
+         * Index from the structural hash of every subtree to its root
+         * Rebuilt lazily on the first lookup after the tree changes
+         *
+         * @param unordered_multimap<unsigned long long, TreeNode*> subtreeIndex
+         */
+        unordered_multimap<unsigned long long, TreeNode*> subtreeIndex;
+
+        /**
+         * Whether the tree changed since the subtree index was built
+         *
+         * @param bool subtreeIndexStale
+         */
+        bool subtreeIndexStale;
+
+        /**
+         * Number of nodes whose left and right heights differ by more than 1
+         * Kept up to date by updateNode, so the tree is balanced when it is 0
+         *
+         * @param int unbalancedNodes
+         */
+        int unbalancedNodes;
+
+        /**
+         * Contiguous node pools allocated by bulkLoad, shared with the trees split from this one
+         * A pool is freed once no tree holds it
+         *
+         * @param vector<shared_ptr<TreeNode>> pools
+         */
+        vector<shared_ptr<TreeNode>> pools;
+
+        /**
+         * Whether splay rotations left structural hashes out of date
+         * Hashes are recomputed before the next read
+         *
+         * @param bool hashesStale
+         */
+        bool hashesStale;
+
         /**
          * Root of the Binary Search Tree
          *
@@ -34,6 +107,121 @@ class BinarySearchTree
          */
         BinarySearchTree();
 
+        /**
+         * Creates an empty Binary Search Tree with the given balancing strategy
+         *
+         * @param BalanceMode mode
+         */
+        BinarySearchTree(BalanceMode mode);
+
+        /**
+         * Recomputes the height, size and sum of curr from its children
+         * And marks curr as touched since the last validation
+         *
+         * @param TreeNode* curr
+         * @return void
+         */
+        void updateNode(TreeNode* curr);
+
+        /**
+         * Recomputes the height, size, sum and balance flag of curr, but not its hash
+         *
+         * @param TreeNode* curr
+         * @return void
+         */
+        void updateCounts(TreeNode* curr);
+
+        /**
+         * Recomputes the structural hash of every node of the tree rooted at root
+         *
+         * @param TreeNode* root
+         * @return void
+         */
+        static void computeHashes(TreeNode* root);
+
+        /**
+         * Returns the structural hash of the tree rooted at root, without changing it
+         *
+         * @param TreeNode* root
+         * @return unsigned long long
+         */
+        static unsigned long long hashOf(TreeNode* root);
+
+        /**
+         * Recomputes the structural hashes if splay rotations left them out of date
+         *
+         * @return void
+         */
+        void refreshHashes();
+
+        /**
+         * Returns height(left) - height(right) of curr
+         *
+         * @param TreeNode* curr
+         * @return int
+         */
+        int getBalanceFactor(TreeNode* curr);
+
+        /**
+         * Rotates the tree rooted at curr to the left
+         * Returns the new root of the rotated tree
+         *
+         * @param TreeNode* curr
+         * @return TreeNode*
+         */
+        TreeNode* rotateLeft(TreeNode* curr);
+
+        /**
+         * Rotates the tree rooted at curr to the right
+         * Returns the new root of the rotated tree
+         *
+         * @param TreeNode* curr
+         * @return TreeNode*
+         */
+        TreeNode* rotateRight(TreeNode* curr);
+
+        /**
+         * Restores the AVL property at curr, if the BST is self balancing
+         * Returns the new root of the tree rooted at curr
+         *
+         * @param TreeNode* curr
+         * @return TreeNode*
+         */
+        TreeNode* rebalance(TreeNode* curr);
+
+        /**
+         * Rotates node above its parent, and re-attaches it to its grandparent
+         *
+         * @param TreeNode* node
+         * @return void
+         */
+        void rotateUp(TreeNode* node);
+
+        /**
+         * Moves node to the root of its tree by zig, zig-zig and zig-zag steps
+         *
+         * @param TreeNode* node
+         * @return void
+         */
+        void splay(TreeNode* node);
+
+        /**
+         * Inserts a new node and splays it to the root
+         *
+         * @param int val
+         * @return void
+         */
+        void splayInsert(int val);
+
+        /**
+         * Splays one node holding val to the root and removes it
+         * Returns whether a node was removed
+         *
+         * @param int val
+         * @return bool
+         */
+        bool splayRemove(int val);
+
         /**
          * Recursively inserts a new node into the Binary Search Tree
          *
@@ -51,6 +239,141 @@ class BinarySearchTree
          */
         void insert(int val);
 
+        /**
+         * Recursively removes one node holding val from the tree rooted at curr
+         * Returns the new root of the tree rooted at curr
+         *
+         * @param TreeNode* curr
+         * @param int val
+         * @param bool& removed
+         * @return TreeNode*
+         */
+        TreeNode* recursiveRemove(TreeNode* curr, int val, bool& removed);
+
+        /**
+         * Removes one node holding val from the Binary Search Tree
+         * Returns whether a node was removed
+         *
+         * @param int val
+         * @return bool
+         */
+        bool remove(int val);
+
+        /**
+         * Frees a node that was unlinked from the tree
+         *
+         * @param TreeNode* node
+         * @return void
+         */
+        void freeNode(TreeNode* node);
+
+        /**
+         * Allocates an uninitialized pool of n nodes, held by the tree
+         *
+         * @param int n
+         * @return TreeNode*
+         */
+        TreeNode* allocatePool(int n);
+
+        /**
+         * Builds a balanced tree of sorted[lo..hi] into pool in pre order
+         * The top forkDepth levels build their left subtree on another thread
+         *
+         * @param TreeNode* pool
+         * @param const int* sorted
+         * @param int lo
+         * @param int hi
+         * @param int forkDepth
+         * @return TreeNode*
+         */
+        static TreeNode* buildBalanced(TreeNode* pool, const int* sorted, int lo, int hi, int forkDepth);
+
+        /**
+         * Replaces the contents of the tree with n values sorted in increasing order
+         * Builds a balanced tree in O(n), without any comparisons
+         *
+         * @param const int* sorted
+         * @param int n
+         * @return void
+         */
+        void bulkLoad(const int* sorted, int n);
+
+        /**
+         * Replaces the contents of the tree with values sorted in increasing order
+         *
+         * @param vector<int>& sorted
+         * @return void
+         */
+        void bulkLoad(vector<int>& sorted);
+
+        /**
+         * Replaces the contents of the tree with n values in the given shape, in O(n)
+         * shape holds 2n bits, 1 for '(' and 0 for ')', and a node is written ( left ) right
+         * values hold the n values in order, one per ')'
+         * Throws if the shape is not balanced parentheses, the values are not sorted,
+         * Or the tree is AVL and the shape breaks the AVL property
+         *
+         * @param const uint64_t* shape
+         * @param const int* values
+         * @param int n
+         * @return void
+         */
+        void loadShape(const uint64_t* shape, const int* values, int n);
+
+        /**
+         * Appends the nodes of the tree rooted at curr to res in order
+         *
+         * @param TreeNode* curr
+         * @param vector<TreeNode*>& res
+         * @return void
+         */
+        static void collectNodes(TreeNode* curr, vector<TreeNode*>& res);
+
+        /**
+         * Links nodes[lo..hi], which are sorted, into a balanced tree and returns its root
+         *
+         * @param vector<TreeNode*>& nodes
+         * @param int lo
+         * @param int hi
+         * @return TreeNode*
+         */
+        TreeNode* linkBalanced(vector<TreeNode*>& nodes, int lo, int hi);
+
+        /**
+         * Replaces the contents of the tree with the sorted nodes, relinked balanced
+         *
+         * @param vector<TreeNode*>& nodes
+         * @return void
+         */
+        void relink(vector<TreeNode*>& nodes);
+
+        /**
+         * Moves every node of other into the tree, in O(n + m), and empties other
+         *
+         * @param BinarySearchTree& other
+         * @return void
+         */
+        void merge(BinarySearchTree& other);
+
+        /**
+         * Moves every node holding a value greater than key into a new tree, in O(n)
+         * Returns the new tree, the values up to key stay
+         *
+         * @param int key
+         * @return BinarySearchTree
+         */
+        BinarySearchTree split(int key);
+
+        /**
+         * Removes every node holding a value in [lo, hi], in O(n)
+         * Returns the number of nodes removed
+         *
+         * @param int lo
+         * @param int hi
+         * @return int
+         */
+        int eraseRange(int lo, int hi);
+
         /**
          * Finds the TreeNode* that contains val, if exists
          *
@@ -62,6 +385,8 @@ class BinarySearchTree
 
         /**
          * Checks whether a value exists in the BST
+         * In SPLAY mode the node found, or the last node visited, moves to the root,
+         * So the lookup modifies the tree and measures slower than in NONE mode
          *
          * @param int val
          * @return bool
@@ -91,6 +416,45 @@ class BinarySearchTree
          */
         vector<int> inOrder();
 
+        /**
+         * Returns an immutable snapshot of the tree in Eytzinger layout
+         * Later changes to the tree are not reflected in the snapshot
+         *
+         * @return EytzingerTree
+         */
+        EytzingerTree freeze();
+
+        /**
+         * Returns an iterator over the tree in order
+         *
+         * @return InOrderIterator
+         */
+        InOrderIterator inOrderIterator();
+
+        /**
+         * Returns an iterator over the tree in pre order
+         *
+         * @return PreOrderIterator
+         */
+        PreOrderIterator preOrderIterator();
+
+        /**
+         * Returns an iterator over the tree in level order
+         *
+         * @return LevelOrderIterator
+         */
+        LevelOrderIterator levelOrderIterator();
+
+        /**
+         * Fills flat buffers with the entire tree in level order, in O(n)
+         * Level i is held in values[levelStarts[i], levelStarts[i+1])
+         *
+         * @param vector<int>& values
+         * @param vector<int>& levelStarts
+         * @return void
+         */
+        void levelOrder(vector<int>& values, vector<int>& levelStarts);
+
         /**
          * Returns the entire tree levelOrder
          *
@@ -121,7 +485,7 @@ class BinarySearchTree
         void printTree();
 
         /**
-         * Returns the height of the tree
+         * Returns the height of the tree rooted at curr, in O(1)
          *
          * @param TreeNode* curr
          * @return int
@@ -129,7 +493,7 @@ class BinarySearchTree
         int getHeight(TreeNode* curr);
 
         /**
-         * Returns the height of the tree
+         * Returns the height of the tree, in O(1)
          * Height of the root is 1
          *
          * @return int
@@ -144,7 +508,8 @@ class BinarySearchTree
         TreeNode* getRoot();
 
         /**
-         * Returns whether the height of the tree is balanced
+         * Returns whether the height of the tree rooted at curr is balanced
+         * O(1) for the root, O(size of the tree) for any other node
          *
          * @param TreeNode* curr
          * @return bool
@@ -152,12 +517,20 @@ class BinarySearchTree
         bool getBalanced(TreeNode* curr);
 
         /**
-         * Returns whether the height of the tree is balanced
+         * Returns whether the height of the tree is balanced, in O(1)
          *
          * @return bool
          */
         bool getBalanced();
 
+        /**
+         * Checks in one O(n) pass that every stored height, size, balance flag
+         * And parent pointer matches the children, and that the counts match the tree
+         *
+         * @return bool
+         */
+        bool audit();
+
         /**
          * Clears the binary tree
          *
@@ -166,7 +539,7 @@ class BinarySearchTree
         void clear();
 
         /**
-         * Gets the nth rank node by in order
+         * Gets the nth rank node by in order in O(height)
          * n must be in the range [1, numVertices]
          *
          * @param int n
@@ -175,7 +548,8 @@ class BinarySearchTree
         TreeNode* getNthRank(int n);
 
         /**
-         * Gets the nth rank node by in order
+         * Gets the nth rank node by in order in the tree rooted at curr
+         * n is left at 0 when the node is found
          *
          * @param TreeNode* curr
          * @param int& n
@@ -183,6 +557,53 @@ class BinarySearchTree
          */
         TreeNode* getNthRank(TreeNode* curr, int& n);
 
+        /**
+         * Returns the number of values less than val
+         * If inclusive, values equal to val are counted as well
+         *
+         * @param int val
+         * @param bool inclusive
+         * @return int
+         */
+        int countBelow(int val, bool inclusive);
+
+        /**
+         * Returns the sum of the values less than val
+         * If inclusive, values equal to val are summed as well
+         *
+         * @param int val
+         * @param bool inclusive
+         * @return long long
+         */
+        long long sumBelow(int val, bool inclusive);
+
+        /**
+         * Returns the rank of the first occurrence of val by in order
+         * If val doesn't exist, returns the rank it would have once inserted
+         *
+         * @param int val
+         * @return int
+         */
+        int rankOf(int val);
+
+        /**
+         * Returns the number of values in the range [lo, hi]
+         *
+         * @param int lo
+         * @param int hi
+         * @return int
+         */
+        int rangeCount(int lo, int hi);
+
+        /**
+         * Returns the sum of the values in the range [lo, hi]
+         *
+         * @param int lo
+         * @param int hi
+         * @return long long
+         */
+        long long rangeSum(int lo, int hi);
+
         /**
          * Generates the pre order string of root
          *
@@ -200,31 +621,81 @@ class BinarySearchTree
          */
         string getPreOrderString(TreeNode* root);
 
+        /**
+         * Rebuilds the subtree index from the stored structural hashes
+         *
+         * @return void
+         */
+        void buildSubtreeIndex();
+
+        /**
+         * Returns whether both trees have the same shape and values
+         *
+         * @param TreeNode* tree1
+         * @param TreeNode* tree2
+         * @return bool
+         */
+        static bool isSameTree(TreeNode* tree1, TreeNode* tree2);
+
         /**
          * Returns whether input tree is a subtree of this tree
+         * The hash of tree2 is computed from its values and shape, so its stored hashes
+         * May be out of date, and tree2 is left unchanged
          *
+         * @param TreeNode* tree2
          * @return bool
          */
         bool isSubtree(TreeNode* tree2);
 
         /**
-         * Returns the number of paths that sum to k
+         * Returns the groups of identical subtrees found across the forest
+         * Only subtrees of at least minSize nodes are reported
          *
-         * @param unordered_map<int, int>& hash
-         * @param TreeNode* root
-         * @param int k
-         * @param int sum
-         * @return int
+         * @param vector<BinarySearchTree*>& forest
+         * @param int minSize
+         * @return vector<vector<TreeNode*>>
+         */
+        static vector<vector<TreeNode*>> findDuplicateSubtrees(vector<BinarySearchTree*>& forest, int minSize);
+
+        /**
+         * Adds to counts[i] the number of downward paths summing to ks[i] that end in
+         * The tree rooted at start, with an explicit stack
+         * table holds the prefix sums of the path above start, sum is the last of them
+         *
+         * @param TreeNode* start
+         * @param long long sum
+         * @param PrefixSumTable& table
+         * @param vector<int>& ks
+         * @param vector<long long>& counts
+         * @return void
          */
-        int numPaths(unordered_map<int, int>& hash, TreeNode* root, int k, int sum);
+        static void numPaths(TreeNode* start, long long sum, PrefixSumTable& table, vector<int>& ks, vector<long long>& counts);
 
         /**
          * Returns the number of paths that sum to k
          *
          * @param int k
-         * @return bool
+         * @return int
          */
         int numPaths(int k);
+
+        /**
+         * Returns the number of paths that sum to each of ks, in one traversal
+         *
+         * @param vector<int>& ks
+         * @return vector<long long>
+         */
+        vector<long long> numPaths(vector<int>& ks);
+
+        /**
+         * Returns the number of paths that sum to each of ks, on numThreads threads
+         * The tree is split at a frontier of subtrees that are counted in parallel
+         *
+         * @param vector<int>& ks
+         * @param int numThreads
+         * @return vector<long long>
+         */
+        vector<long long> numPaths(vector<int>& ks, int numThreads);
 };
 
 #endif
@@ -0,0 +1,288 @@
+#include "bst-validator.h"
+#include <vector>
+#include <utility>
+#include <thread>
+#include <atomic>
+#include <limits>
+
+using namespace std;
+
+/**
+ * Creates a validator which uses up to numThreads threads
+ *
+ * @param int numThreads
+ */
+BstValidator::BstValidator(int numThreads)
+{
+    this->numThreads = numThreads < 1 ? 1 : numThreads;
+
+    this->reset();
+}
+
+/**
+ * Resets the result of the last call
+ *
+ * @return void
+ */
+void BstValidator::reset()
+{
+    this->failed = false;
+
+    this->violation = nullptr;
+
+    this->reason = nullptr;
+
+    this->checked = 0;
+}
+
+/**
+ * Records node as breaking an invariant, returns false
+ * Only the first violation is kept, with its reason
+ *
+ * @param TreeNode* node
+ * @param const char* reason
+ * @return bool
+ */
+bool BstValidator::fail(TreeNode* node, const char* reason)
+{
+    TreeNode* none = nullptr;
+
+    if (this->violation.compare_exchange_strong(none, node)) this->reason = reason;
+
+    this->failed = true;
+
+    return false;
+}
+
+/**
+ * Checks node against the bounds [lo, hi] and against its children
+ * And clears its touched flag
+ *
+ * @param TreeNode* node
+ * @param long long lo
+ * @param long long hi
+ * @return bool
+ */
+bool BstValidator::checkNode(TreeNode* node, long long lo, long long hi)
+{
+    if (node->value < lo || node->value > hi) return this->fail(node, "value out of bounds");
+
+    if (node->left && node->left->parent != node) return this->fail(node->left, "wrong parent");
+
+    if (node->right && node->right->parent != node) return this->fail(node->right, "wrong parent");
+
+    int heightL = node->left ? node->left->height : 0;
+
+    int heightR = node->right ? node->right->height : 0;
+
+    int sizeL = node->left ? node->left->size : 0;
+
+    int sizeR = node->right ? node->right->size : 0;
+
+    if (node->height != 1 + max(heightL, heightR)) return this->fail(node, "stale height");
+
+    if (node->size != 1 + sizeL + sizeR) return this->fail(node, "stale size");
+
+    node->touched = false;
+
+    return true;
+}
+
+/**
+ * Checks every node in the tree rooted at node on the calling thread
+ * Explicit stack, so a degenerate tree can't overflow the call stack
+ *
+ * @param TreeNode* node
+ * @param long long lo
+ * @param long long hi
+ * @return bool
+ */
+bool BstValidator::validateSubtree(TreeNode* node, long long lo, long long hi)
+{
+    if (!node) return true;
+
+    vector<pair<TreeNode*, pair<long long, long long>>> stack;
+
+    stack.push_back({node, {lo, hi}});
+
+    long long count = 0;
+
+    while (!stack.empty() && !this->failed.load(memory_order_relaxed))
+    {
+        TreeNode* curr = stack.back().first;
+
+        long long currLo = stack.back().second.first;
+
+        long long currHi = stack.back().second.second;
+
+        stack.pop_back();
+
+        count++;
+
+        if (!this->checkNode(curr, currLo, currHi)) break;
+
+        if (curr->left) stack.push_back({curr->left, {currLo, curr->value}});
+
+        if (curr->right) stack.push_back({curr->right, {curr->value, currHi}});
+    }
+
+    this->checked += count;
+
+    return !this->failed;
+}
+
+/**
+ * Checks every node in the tree rooted at node
+ * The top forkDepth levels check their left subtree on another thread
+ *
+ * @param TreeNode* node
+ * @param long long lo
+ * @param long long hi
+ * @param int forkDepth
+ * @return bool
+ */
+bool BstValidator::validateParallel(TreeNode* node, long long lo, long long hi, int forkDepth)
+{
+    // Sizes are under validation too, but a wrong one only misjudges the split
+    if (!node || forkDepth == 0 || node->size < VALIDATE_GRAIN) return this->validateSubtree(node, lo, hi);
+
+    this->checked++;
+
+    if (!this->checkNode(node, lo, hi)) return false;
+
+    bool leftValid = true;
+
+    thread leftThread([&]() {
+        leftValid = this->validateParallel(node->left, lo, node->value, forkDepth-1);
+    });
+
+    bool rightValid = this->validateParallel(node->right, node->value, hi, forkDepth-1);
+
+    leftThread.join();
+
+    return leftValid && rightValid;
+}
+
+/**
+ * Checks every node in the tree rooted at root, in O(n) work
+ *
+ * @param TreeNode* root
+ * @return bool
+ */
+bool BstValidator::validate(TreeNode* root)
+{
+    this->reset();
+
+    if (!root) return true;
+
+    if (root->parent) return this->fail(root, "root has a parent");
+
+    int forkDepth = 0;
+
+    while ((2 << forkDepth) <= this->numThreads) forkDepth++;
+
+    return this->validateParallel(root, numeric_limits<long long>::min(), numeric_limits<long long>::max(), forkDepth);
+}
+
+/**
+ * Checks the nodes touched since they were last validated, and the
+ * Bounds of the subtrees of their untouched children, in O(changed paths * height) work
+ * Every change updates all of its ancestors, so the touched nodes are the
+ * Paths from the root to the changes, and an untouched child heads a
+ * Subtree that was valid at the last validation and hasn't changed since
+ * Its bounds may have, so its smallest and largest values are checked against them
+ *
+ * @param TreeNode* root
+ * @return bool
+ */
+bool BstValidator::validateTouched(TreeNode* root)
+{
+    this->reset();
+
+    if (!root || !root->touched) return true;
+
+    if (root->parent) return this->fail(root, "root has a parent");
+
+    vector<pair<TreeNode*, pair<long long, long long>>> stack;
+
+    stack.push_back({root, {numeric_limits<long long>::min(), numeric_limits<long long>::max()}});
+
+    while (!stack.empty())
+    {
+        TreeNode* curr = stack.back().first;
+
+        long long lo = stack.back().second.first;
+
+        long long hi = stack.back().second.second;
+
+        stack.pop_back();
+
+        this->checked++;
+
+        if (!this->checkNode(curr, lo, hi)) return false;
+
+        TreeNode* children[2] = {curr->left, curr->right};
+
+        pair<long long, long long> bounds[2] = {{lo, curr->value}, {curr->value, hi}};
+
+        for (int i=0; i<2; i++)
+        {
+            if (!children[i]) continue;
+
+            if (children[i]->touched)
+            {
+                stack.push_back({children[i], bounds[i]});
+
+                continue;
+            }
+
+            // A rotation may have moved the subtree under new bounds, and as it is
+            // Unchanged and ordered, its extremes are its left most and right most nodes
+            TreeNode* smallest = children[i];
+
+            TreeNode* largest = children[i];
+
+            while (smallest->left) smallest = smallest->left;
+
+            while (largest->right) largest = largest->right;
+
+            if (smallest->value < bounds[i].first) return this->fail(smallest, "value out of bounds");
+
+            if (largest->value > bounds[i].second) return this->fail(largest, "value out of bounds");
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Returns the first node found to break an invariant by the last call
+ * nullptr if the last call found none
+ *
+ * @return TreeNode*
+ */
+TreeNode* BstValidator::getViolation()
+{
+    return this->violation;
+}
+
+/**
+ * Returns the invariant broken by the violation of the last call
+ * nullptr if the last call found none
+ *
+ * @return const char*
+ */
+const char* BstValidator::getReason()
+{
+    return this->reason;
+}
+
+/**
+ * Returns the number of nodes checked by the last call
+ *
+ * @return long long
+ */
+long long BstValidator::getNumChecked()
+{
+    return this->checked;
+}
@@ -0,0 +1,162 @@
+#ifndef BST_VALIDATOR
+#define BST_VALIDATOR
+
+#include "binary-search-tree.h"
+#include <vector>
+#include <atomic>
+
+using namespace std;
+
+/**
+ * Subtrees smaller than this are never validated on a separate thread
+ */
+const int VALIDATE_GRAIN = 1 << 15;
+
+/**
+ * Checks the invariants of a BinarySearchTree in one pass over its nodes
+ * Every node must lie within the bounds set by its ancestors, its children
+ * Must point back to it, and its stored height and size must match its children
+ * Bounds are long long, so values at INT_MIN and INT_MAX need no sentinel
+ * Values equal to a node may sit on either side of it, as rotations move them
+ *
+ * validate checks the whole tree, forking a thread per subtree on the top levels
+ * validateTouched only checks the nodes created or updated since the last
+ * Validation, which form the paths from the root to every change
+ */
+class BstValidator
+{
+    private:
+        /**
+         * Number of threads validate may use
+         *
+         * @param int numThreads
+         */
+        int numThreads;
+
+        /**
+         * Set on the first violation, so the other threads stop early
+         *
+         * @param atomic<bool> failed
+         */
+        atomic<bool> failed;
+
+        /**
+         * First node found to break an invariant by the last call
+         *
+         * @param atomic<TreeNode*> violation
+         */
+        atomic<TreeNode*> violation;
+
+        /**
+         * Invariant broken by the violation, written by the thread that recorded it
+         *
+         * @param const char* reason
+         */
+        const char* reason;
+
+        /**
+         * Number of nodes checked by the last call
+         *
+         * @param atomic<long long> checked
+         */
+        atomic<long long> checked;
+
+        /**
+         * Records node as breaking an invariant, returns false
+         *
+         * @param TreeNode* node
+         * @param const char* reason
+         * @return bool
+         */
+        bool fail(TreeNode* node, const char* reason);
+
+        /**
+         * Checks node against the bounds [lo, hi] and against its children
+         * And clears its touched flag
+         *
+         * @param TreeNode* node
+         * @param long long lo
+         * @param long long hi
+         * @return bool
+         */
+        bool checkNode(TreeNode* node, long long lo, long long hi);
+
+        /**
+         * Checks every node in the tree rooted at node on the calling thread
+         *
+         * @param TreeNode* node
+         * @param long long lo
+         * @param long long hi
+         * @return bool
+         */
+        bool validateSubtree(TreeNode* node, long long lo, long long hi);
+
+        /**
+         * Checks every node in the tree rooted at node
+         * The top forkDepth levels check their left subtree on another thread
+         *
+         * @param TreeNode* node
+         * @param long long lo
+         * @param long long hi
+         * @param int forkDepth
+         * @return bool
+         */
+        bool validateParallel(TreeNode* node, long long lo, long long hi, int forkDepth);
+
+        /**
+         * Resets the result of the last call
+         *
+         * @return void
+         */
+        void reset();
+
+    public:
+        /**
+         * Creates a validator which uses up to numThreads threads
+         *
+         * @param int numThreads
+         */
+        BstValidator(int numThreads);
+
+        /**
+         * Checks every node in the tree rooted at root, in O(n) work
+         *
+         * @param TreeNode* root
+         * @return bool
+         */
+        bool validate(TreeNode* root);
+
+        /**
+         * Checks the nodes touched since they were last validated, and the
+         * Bounds of the subtrees of their untouched children, in O(changed paths * height) work
+         *
+         * @param TreeNode* root
+         * @return bool
+         */
+        bool validateTouched(TreeNode* root);
+
+        /**
+         * Returns the first node found to break an invariant by the last call
+         * nullptr if the last call found none
+         *
+         * @return TreeNode*
+         */
+        TreeNode* getViolation();
+
+        /**
+         * Returns the invariant broken by the violation of the last call
+         * nullptr if the last call found none
+         *
+         * @return const char*
+         */
+        const char* getReason();
+
+        /**
+         * Returns the number of nodes checked by the last call
+         *
+         * @return long long
+         */
+        long long getNumChecked();
+};
+
+#endif
@@ -13,51 +13,60 @@ using namespace std;
  */
 
 /**
- * Performs a dfs on the graph
+ * Returns a build order of the projects, dependencies first, in O(V + E)
+ * Projects in a dependency cycle can't be built one after another, so each
+ * Cycle is built as one group, and is added to cycles
+ * The order is taken over the condensation, by Kahn's algorithm, so a deep
+ * Chain of dependencies doesn't recurse
  *
  * @param DirectedGraph& dg
- * @param int curr
- * @param vector<bool>& visited
- * @param vector<int>& res
- * @return void
+ * @param vector<vector<int>>& cycles
+ * @return vector<int>
  */
-void dfs(DirectedGraph& dg, int curr, vector<bool>& visited, vector<int>& res)
+vector<int> buildOrder(DirectedGraph& dg, vector<vector<int>>& cycles)
 {
-    if (visited[curr]) return;
+    vector<int> component;
+
+    DirectedGraph dag = dg.condensation(component);
+
+    cycles = dg.cycles(component);
+
+    vector<vector<int>> members(dag.getNumVertices());
+
+    for (int v=0; v<dg.getNumVertices(); v++) members[component[v]].push_back(v);
 
-    visited[curr] = true;
+    vector<int> order = dag.topologicalSort(), res;
 
-    for (int v : dg.getAdjList(curr))
+    // Edges go from a project to its dependencies, so the build order is the reverse
+    for (int i=order.size()-1; i>=0; i--)
     {
-        dfs(dg, v, visited, res);
+        for (int v : members[order[i]]) res.push_back(v);
     }
 
-    res.push_back(curr);
+    return res;
 }
 
 /**
- * Returns a topological sort of the directed graph
+ * Prints a build order, and the cycles found
  *
- * @param DirectedGraph& dg
- * @param int n
- * @param int start
- * @return vector<int>
+ * @param vector<int>& order
+ * @param vector<vector<int>>& cycles
+ * @return void
  */
-vector<int> topologicalSort(DirectedGraph& dg, int n, int start)
+void printBuildOrder(vector<int>& order, vector<vector<int>>& cycles)
 {
-    // Start with vertex 0
-    vector<bool> visited(n, false);
+    for (int elem : order) cout << elem << " ";
 
-    vector<int> res;
+    cout << endl;
 
-    for (int i=0; i<n; i++)
+    for (vector<int>& cycle : cycles)
     {
-        if (visited[i]) continue;
+        cout << "Cycle: ";
 
-        dfs(dg, i, visited, res);
-    }
+        for (int elem : cycle) cout << elem << " ";
 
-    return res;
+        cout << endl;
+    }
 }
 
 int main()
@@ -78,9 +87,29 @@ int main()
 
     dg.addEdges(edges);
 
-    vector<int> topoSort = topologicalSort(dg, 6, 0);
+    dg.finalize();
 
-    for (int elem : topoSort) cout << elem << " ";
+    vector<vector<int>> cycles;
 
-    cout << endl;
+    vector<int> order = buildOrder(dg, cycles);
+
+    printBuildOrder(order, cycles);
+
+    // f depends on c, closing the cycle c -> d -> b -> f -> c
+    dg.addEdge(5, 2);
+
+    order = buildOrder(dg, cycles);
+
+    printBuildOrder(order, cycles);
+
+    // A chain of a million projects, each dependent on the next
+    int n = 1000000;
+
+    DirectedGraph chain = DirectedGraph(n);
+
+    for (int i=0; i<n-1; i++) chain.addEdge(i, i+1);
+
+    order = buildOrder(chain, cycles);
+
+    cout << "Chain: first " << order.front() << " last " << order.back() << " cycles " << cycles.size() << endl;
 }
@@ -11,40 +11,6 @@ using namespace std;
  * @see binary-search-tree.cpp
  */
 
-/**
- * Creates a tree of minimal height
- *
- * @param BinarySearchTree& bst
- * @param vectorint>& v
- * @param int start
- * @param int end
- * @return void
- */
-void minimalTree(BinarySearchTree& bst, vector<int>& v, int start, int end)
-{
-    if (start > end) return;
-
-    int mid = (start + end) / 2;
-
-    bst.insert(v[mid]);
-
-    minimalTree(bst, v, start, mid-1);
-
-    minimalTree(bst, v, mid+1, end);
-}
-
-/**
- * Creates a tree of minimal height
- *
- * @param BinarySearchTree& bst
- * @param vectorint>& v
- * @return void
- */
-void minimalTree(BinarySearchTree& bst, vector<int>& v)
-{
-    minimalTree(bst, v, 0, v.size()-1);
-}
-
 int main()
 {
     BinarySearchTree bst = BinarySearchTree();
@@ -55,7 +21,7 @@ int main()
 
     cout << endl;
 
-    minimalTree(bst, v);
+    bst.bulkLoad(v);
 
     printf("The height of the tree after insertion %d\n", bst.getHeight());
 
@@ -84,4 +50,9 @@ int main()
     cout << endl;
 
     printf("Is the height of the tree balanced %d\n", bst.getBalanced());
+
+    cout << endl;
+
+    // Heights and balance are kept up to date incrementally, the audit rechecks them all
+    printf("Do the stored heights pass the audit %d\n", bst.audit());
 }
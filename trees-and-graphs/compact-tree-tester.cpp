@@ -0,0 +1,79 @@
+#include "compact-tree.cpp"
+#include "binary-search-tree.cpp"
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <random>
+#include <string>
+
+using namespace std;
+
+/**
+ * Checks the compact tree against the Binary Search Tree
+ * Then saves it, loads it back, and compares the memory of both trees
+ *
+ * Usage: ./compact-tree-tester [numKeys]
+ *
+ * @see compact-tree.cpp
+ * @see binary-search-tree.cpp
+ */
+
+int main(int argc, char** argv)
+{
+    int numKeys = argc > 1 ? stoi(argv[1]) : 1000000;
+
+    CompactTree compact = CompactTree();
+
+    BinarySearchTree bst = BinarySearchTree(BalanceMode::AVL);
+
+    mt19937 rng(42);
+
+    for (int i=0; i<numKeys; i++)
+    {
+        int val = rng() % numKeys;
+
+        compact.insert(val);
+
+        bst.insert(val);
+    }
+
+    for (int i=0; i<numKeys/4; i++)
+    {
+        int val = rng() % numKeys;
+
+        compact.remove(val);
+
+        bst.remove(val);
+    }
+
+    bool matches = compact.inOrder() == bst.inOrder();
+
+    matches = matches && compact.levelOrder() == bst.levelOrder();
+
+    matches = matches && compact.getHeight() == bst.getHeight();
+
+    for (int i=0; i<1000; i++)
+    {
+        int val = rng() % numKeys;
+
+        int n = 1 + rng() % bst.getNumVertices();
+
+        matches = matches && compact.exists(val) == bst.exists(val);
+
+        matches = matches && compact.getNthRank(n) == bst.getNthRank(n)->getValue();
+    }
+
+    printf("Compact tree matches the BST after inserts and removes %d\n", matches);
+
+    stringstream buffer;
+
+    compact.serialize(buffer);
+
+    CompactTree loaded = CompactTree::deserialize(buffer);
+
+    printf("Loaded tree matches the saved tree %d\n", loaded.inOrder() == compact.inOrder());
+
+    printf("Bytes per node: compact %zu, BST %zu\n", sizeof(CompactNode), sizeof(TreeNode));
+
+    printf("Saved tree size %zu bytes for %d values\n", buffer.str().size(), loaded.getNumVertices());
+}
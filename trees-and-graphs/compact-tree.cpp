@@ -0,0 +1,608 @@
+#include "compact-tree.h"
+#include <algorithm>
+#include <queue>
+#include <utility>
+
+using namespace std;
+
+/**
+ * This is an implementation of an AVL tree stored in a single array
+ * Children and parents are 32 bit indices instead of 8 byte pointers
+ * So the whole tree is relocatable, and can be saved with one write
+ */
+
+/**
+ * Magic number at the start of a serialized compact tree
+ */
+const uint32_t COMPACT_MAGIC = 0x43545245;
+
+/**
+ * Returns the height of the tree rooted at this node
+ *
+ * @return int
+ */
+int CompactNode::getHeight()
+{
+    return this->meta & 63;
+}
+
+/**
+ * Returns the number of nodes in the tree rooted at this node
+ *
+ * @return int
+ */
+int CompactNode::getSize()
+{
+    return this->meta >> 6;
+}
+
+/**
+ * Sets the height and size of the tree rooted at this node
+ *
+ * @param int height
+ * @param int size
+ * @return void
+ */
+void CompactNode::setMeta(int height, int size)
+{
+    this->meta = ((uint32_t) size << 6) | (uint32_t) height;
+}
+
+/**
+ * Creates an empty compact tree
+ */
+CompactTree::CompactTree()
+{
+    this->root = COMPACT_NIL;
+
+    this->freeHead = COMPACT_NIL;
+
+    this->size = 0;
+}
+
+/**
+ * Returns the height of the tree rooted at i
+ *
+ * @param uint32_t i
+ * @return int
+ */
+int CompactTree::heightOf(uint32_t i)
+{
+    return i == COMPACT_NIL ? 0 : this->nodes[i].getHeight();
+}
+
+/**
+ * Returns the number of nodes in the tree rooted at i
+ *
+ * @param uint32_t i
+ * @return int
+ */
+int CompactTree::sizeOf(uint32_t i)
+{
+    return i == COMPACT_NIL ? 0 : this->nodes[i].getSize();
+}
+
+/**
+ * Returns the index of a new leaf holding val
+ * Free slots are reused before the array grows
+ *
+ * @param int val
+ * @return uint32_t
+ */
+uint32_t CompactTree::allocate(int val)
+{
+    uint32_t i = this->freeHead;
+
+    if (i != COMPACT_NIL)
+    {
+        this->freeHead = this->nodes[i].right;
+    }
+    else
+    {
+        i = this->nodes.size();
+
+        this->nodes.push_back(CompactNode());
+    }
+
+    CompactNode& node = this->nodes[i];
+
+    node.value = val;
+
+    node.left = COMPACT_NIL;
+
+    node.right = COMPACT_NIL;
+
+    node.parent = COMPACT_NIL;
+
+    node.setMeta(1, 1);
+
+    return i;
+}
+
+/**
+ * Returns the slot of i to the free list
+ *
+ * @param uint32_t i
+ * @return void
+ */
+void CompactTree::release(uint32_t i)
+{
+    this->nodes[i].right = this->freeHead;
+
+    this->freeHead = i;
+}
+
+/**
+ * Sets the left child of i, and the parent of the child
+ *
+ * @param uint32_t i
+ * @param uint32_t child
+ * @return void
+ */
+void CompactTree::setLeftChild(uint32_t i, uint32_t child)
+{
+    this->nodes[i].left = child;
+
+    if (child != COMPACT_NIL) this->nodes[child].parent = i;
+}
+
+/**
+ * Sets the right child of i, and the parent of the child
+ *
+ * @param uint32_t i
+ * @param uint32_t child
+ * @return void
+ */
+void CompactTree::setRightChild(uint32_t i, uint32_t child)
+{
+    this->nodes[i].right = child;
+
+    if (child != COMPACT_NIL) this->nodes[child].parent = i;
+}
+
+/**
+ * Recomputes the height and size of i from its children
+ *
+ * @param uint32_t i
+ * @return void
+ */
+void CompactTree::updateNode(uint32_t i)
+{
+    uint32_t left = this->nodes[i].left;
+
+    uint32_t right = this->nodes[i].right;
+
+    int height = 1 + max(this->heightOf(left), this->heightOf(right));
+
+    this->nodes[i].setMeta(height, 1 + this->sizeOf(left) + this->sizeOf(right));
+}
+
+/**
+ * Rotates the tree rooted at i to the left, returns the new root
+ *
+ * @param uint32_t i
+ * @return uint32_t
+ */
+uint32_t CompactTree::rotateLeft(uint32_t i)
+{
+    uint32_t pivot = this->nodes[i].right;
+
+    this->setRightChild(i, this->nodes[pivot].left);
+
+    this->setLeftChild(pivot, i);
+
+    this->updateNode(i);
+
+    this->updateNode(pivot);
+
+    return pivot;
+}
+
+/**
+ * Rotates the tree rooted at i to the right, returns the new root
+ *
+ * @param uint32_t i
+ * @return uint32_t
+ */
+uint32_t CompactTree::rotateRight(uint32_t i)
+{
+    uint32_t pivot = this->nodes[i].left;
+
+    this->setLeftChild(i, this->nodes[pivot].right);
+
+    this->setRightChild(pivot, i);
+
+    this->updateNode(i);
+
+    this->updateNode(pivot);
+
+    return pivot;
+}
+
+/**
+ * Restores the AVL property at i, returns the new root
+ *
+ * @param uint32_t i
+ * @return uint32_t
+ */
+uint32_t CompactTree::rebalance(uint32_t i)
+{
+    this->updateNode(i);
+
+    uint32_t left = this->nodes[i].left;
+
+    uint32_t right = this->nodes[i].right;
+
+    int balance = this->heightOf(left) - this->heightOf(right);
+
+    if (balance > 1)
+    {
+        if (this->heightOf(this->nodes[left].left) < this->heightOf(this->nodes[left].right))
+        {
+            this->setLeftChild(i, this->rotateLeft(left));
+        }
+
+        return this->rotateRight(i);
+    }
+    else if (balance < -1)
+    {
+        if (this->heightOf(this->nodes[right].right) < this->heightOf(this->nodes[right].left))
+        {
+            this->setRightChild(i, this->rotateRight(right));
+        }
+
+        return this->rotateLeft(i);
+    }
+
+    return i;
+}
+
+/**
+ * Recursively inserts val into the tree rooted at i, returns the new root
+ * Allocation may move the node array, so nodes are only held by index
+ *
+ * @param uint32_t i
+ * @param int val
+ * @return uint32_t
+ */
+uint32_t CompactTree::recursiveInsert(uint32_t i, int val)
+{
+    if (i == COMPACT_NIL) return this->allocate(val);
+
+    if (this->nodes[i].value >= val)
+    {
+        uint32_t left = this->recursiveInsert(this->nodes[i].left, val);
+
+        this->setLeftChild(i, left);
+    }
+    else
+    {
+        uint32_t right = this->recursiveInsert(this->nodes[i].right, val);
+
+        this->setRightChild(i, right);
+    }
+
+    return this->rebalance(i);
+}
+
+/**
+ * Recursively removes one val from the tree rooted at i, returns the new root
+ *
+ * @param uint32_t i
+ * @param int val
+ * @param bool& removed
+ * @return uint32_t
+ */
+uint32_t CompactTree::recursiveRemove(uint32_t i, int val, bool& removed)
+{
+    if (i == COMPACT_NIL) return i;
+
+    if (this->nodes[i].value > val)
+    {
+        this->setLeftChild(i, this->recursiveRemove(this->nodes[i].left, val, removed));
+    }
+    else if (this->nodes[i].value < val)
+    {
+        this->setRightChild(i, this->recursiveRemove(this->nodes[i].right, val, removed));
+    }
+    else
+    {
+        removed = true;
+
+        uint32_t left = this->nodes[i].left;
+
+        uint32_t right = this->nodes[i].right;
+
+        if (left == COMPACT_NIL || right == COMPACT_NIL)
+        {
+            this->release(i);
+
+            return left != COMPACT_NIL ? left : right;
+        }
+
+        // Two children, so i takes over the value of its in order successor
+        uint32_t successor = right;
+
+        while (this->nodes[successor].left != COMPACT_NIL) successor = this->nodes[successor].left;
+
+        int successorValue = this->nodes[successor].value;
+
+        this->nodes[i].value = successorValue;
+
+        bool removedSuccessor = false;
+
+        this->setRightChild(i, this->recursiveRemove(right, successorValue, removedSuccessor));
+    }
+
+    return this->rebalance(i);
+}
+
+/**
+ * Inserts a new value into the tree
+ * Throws once the tree holds COMPACT_MAX_NODES values
+ *
+ * @param int val
+ * @return void
+ */
+void CompactTree::insert(int val)
+{
+    if (this->size >= (int) COMPACT_MAX_NODES) throw "Compact tree is full";
+
+    this->root = this->recursiveInsert(this->root, val);
+
+    this->nodes[this->root].parent = COMPACT_NIL;
+
+    this->size++;
+}
+
+/**
+ * Removes one node holding val, returns whether a node was removed
+ *
+ * @param int val
+ * @return bool
+ */
+bool CompactTree::remove(int val)
+{
+    bool removed = false;
+
+    this->root = this->recursiveRemove(this->root, val, removed);
+
+    if (this->root != COMPACT_NIL) this->nodes[this->root].parent = COMPACT_NIL;
+
+    if (removed) this->size--;
+
+    return removed;
+}
+
+/**
+ * Checks whether a value exists in the tree
+ *
+ * @param int val
+ * @return bool
+ */
+bool CompactTree::exists(int val)
+{
+    uint32_t i = this->root;
+
+    while (i != COMPACT_NIL && this->nodes[i].value != val)
+    {
+        i = this->nodes[i].value > val ? this->nodes[i].left : this->nodes[i].right;
+    }
+
+    return i != COMPACT_NIL;
+}
+
+/**
+ * Returns the number of values in the tree
+ *
+ * @return int
+ */
+int CompactTree::getNumVertices()
+{
+    return this->size;
+}
+
+/**
+ * Returns the height of the tree
+ *
+ * @return int
+ */
+int CompactTree::getHeight()
+{
+    return this->heightOf(this->root);
+}
+
+/**
+ * Returns the entire tree inOrder
+ * The walk follows parent indices, so it needs no stack
+ *
+ * @return vector<int>
+ */
+vector<int> CompactTree::inOrder()
+{
+    vector<int> res;
+
+    res.reserve(this->size);
+
+    uint32_t i = this->root;
+
+    if (i == COMPACT_NIL) return res;
+
+    while (this->nodes[i].left != COMPACT_NIL) i = this->nodes[i].left;
+
+    while (i != COMPACT_NIL)
+    {
+        res.push_back(this->nodes[i].value);
+
+        if (this->nodes[i].right != COMPACT_NIL)
+        {
+            i = this->nodes[i].right;
+
+            while (this->nodes[i].left != COMPACT_NIL) i = this->nodes[i].left;
+
+            continue;
+        }
+
+        // Go up until we leave a left subtree
+        uint32_t parent = this->nodes[i].parent;
+
+        while (parent != COMPACT_NIL && this->nodes[parent].right == i)
+        {
+            i = parent;
+
+            parent = this->nodes[i].parent;
+        }
+
+        i = parent;
+    }
+
+    return res;
+}
+
+/**
+ * Returns the entire tree levelOrder
+ *
+ * @return vector<vector<int>>
+ */
+vector<vector<int>> CompactTree::levelOrder()
+{
+    vector<vector<int>> res(this->getHeight(), vector<int>());
+
+    if (this->root == COMPACT_NIL) return res;
+
+    queue<pair<uint32_t, int>> levelOrderQ;
+
+    levelOrderQ.push(make_pair(this->root, 0));
+
+    while (!levelOrderQ.empty())
+    {
+        pair<uint32_t, int> p = levelOrderQ.front();
+
+        levelOrderQ.pop();
+
+        CompactNode& node = this->nodes[p.first];
+
+        res[p.second].push_back(node.value);
+
+        if (node.left != COMPACT_NIL) levelOrderQ.push(make_pair(node.left, p.second+1));
+
+        if (node.right != COMPACT_NIL) levelOrderQ.push(make_pair(node.right, p.second+1));
+    }
+
+    return res;
+}
+
+/**
+ * Gets the nth value by in order
+ * n must be in the range [1, numVertices]
+ *
+ * @param int n
+ * @return int
+ */
+int CompactTree::getNthRank(int n)
+{
+    uint32_t i = this->root;
+
+    while (true)
+    {
+        int leftSize = this->sizeOf(this->nodes[i].left);
+
+        if (n <= leftSize)
+        {
+            i = this->nodes[i].left;
+        }
+        else if (n == leftSize + 1)
+        {
+            return this->nodes[i].value;
+        }
+        else
+        {
+            n -= leftSize + 1;
+
+            i = this->nodes[i].right;
+        }
+    }
+}
+
+/**
+ * Returns the number of bytes held by the node array
+ *
+ * @return size_t
+ */
+size_t CompactTree::getMemoryUsage()
+{
+    return this->nodes.capacity() * sizeof(CompactNode);
+}
+
+/**
+ * Writes the tree to out, the node array goes out in a single write
+ * The format is magic, node count, root, free head, size and then the nodes
+ *
+ * @param ostream& out
+ * @return void
+ */
+void CompactTree::serialize(ostream& out)
+{
+    uint32_t header[5] = {
+        COMPACT_MAGIC,
+        (uint32_t) this->nodes.size(),
+        this->root,
+        this->freeHead,
+        (uint32_t) this->size,
+    };
+
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    out.write(reinterpret_cast<const char*>(this->nodes.data()), this->nodes.size() * sizeof(CompactNode));
+}
+
+/**
+ * Reads a tree written by serialize
+ * Throws if the input is not a compact tree, or any index is out of the node array
+ *
+ * @param istream& in
+ * @return CompactTree
+ */
+CompactTree CompactTree::deserialize(istream& in)
+{
+    uint32_t header[5];
+
+    in.read(reinterpret_cast<char*>(header), sizeof(header));
+
+    if (!in || header[0] != COMPACT_MAGIC) throw "Input is not a compact tree";
+
+    uint32_t count = header[1];
+
+    // Checked before the array is allocated, so a bad count can't ask for gigabytes
+    if (count > COMPACT_MAX_NODES || header[4] > count) throw "Compact tree is corrupt";
+
+    if ((header[2] != COMPACT_NIL && header[2] >= count) || (header[3] != COMPACT_NIL && header[3] >= count))
+    {
+        throw "Compact tree is corrupt";
+    }
+
+    CompactTree tree = CompactTree();
+
+    tree.nodes.resize(header[1]);
+
+    tree.root = header[2];
+
+    tree.freeHead = header[3];
+
+    tree.size = header[4];
+
+    in.read(reinterpret_cast<char*>(tree.nodes.data()), tree.nodes.size() * sizeof(CompactNode));
+
+    if (!in) throw "Compact tree is truncated";
+
+    for (CompactNode& node : tree.nodes)
+    {
+        if ((node.left != COMPACT_NIL && node.left >= count) || (node.right != COMPACT_NIL && node.right >= count) ||
+            (node.parent != COMPACT_NIL && node.parent >= count))
+        {
+            throw "Compact tree is corrupt";
+        }
+    }
+
+    return tree;
+}
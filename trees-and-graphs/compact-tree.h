@@ -0,0 +1,314 @@
+#ifndef COMPACT_TREE
+#define COMPACT_TREE
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <iostream>
+
+using namespace std;
+
+/**
+ * Index used for a missing child or parent
+ */
+const uint32_t COMPACT_NIL = 0xffffffff;
+
+/**
+ * Subtree sizes share a 32 bit word with the height, so they are limited to 26 bits
+ */
+const uint32_t COMPACT_MAX_NODES = (1u << 26) - 1;
+
+class CompactNode
+{
+    public:
+        /**
+         * Value held at the node
+         *
+         * @param int value
+         */
+        int value;
+
+        /**
+         * Index of the left child of the node
+         *
+         * @param uint32_t left
+         */
+        uint32_t left;
+
+        /**
+         * Index of the right child of the node
+         * Free slots use it to link to the next free slot
+         *
+         * @param uint32_t right
+         */
+        uint32_t right;
+
+        /**
+         * Index of the parent of the node
+         *
+         * @param uint32_t parent
+         */
+        uint32_t parent;
+
+        /**
+         * Height of the tree rooted at this node in the low 6 bits
+         * Number of nodes in the tree rooted at this node in the high 26 bits
+         *
+         * @param uint32_t meta
+         */
+        uint32_t meta;
+
+        /**
+         * Returns the height of the tree rooted at this node
+         *
+         * @return int
+         */
+        int getHeight();
+
+        /**
+         * Returns the number of nodes in the tree rooted at this node
+         *
+         * @return int
+         */
+        int getSize();
+
+        /**
+         * Sets the height and size of the tree rooted at this node
+         *
+         * @param int height
+         * @param int size
+         * @return void
+         */
+        void setMeta(int height, int size);
+};
+
+/**
+ * AVL tree with all nodes held in one array, linked by 32 bit indices
+ * A node takes 20 bytes, and the tree can be written out and read back as is
+ */
+class CompactTree
+{
+    private:
+        /**
+         * Node slots, including free ones
+         *
+         * @param vector<CompactNode> nodes
+         */
+        vector<CompactNode> nodes;
+
+        /**
+         * Index of the root
+         *
+         * @param uint32_t root
+         */
+        uint32_t root;
+
+        /**
+         * Index of the first free slot, slots are linked through right
+         *
+         * @param uint32_t freeHead
+         */
+        uint32_t freeHead;
+
+        /**
+         * Number of elements in the tree
+         *
+         * @param int size
+         */
+        int size;
+
+        /**
+         * Returns the height of the tree rooted at i
+         *
+         * @param uint32_t i
+         * @return int
+         */
+        int heightOf(uint32_t i);
+
+        /**
+         * Returns the number of nodes in the tree rooted at i
+         *
+         * @param uint32_t i
+         * @return int
+         */
+        int sizeOf(uint32_t i);
+
+        /**
+         * Returns the index of a new leaf holding val
+         *
+         * @param int val
+         * @return uint32_t
+         */
+        uint32_t allocate(int val);
+
+        /**
+         * Returns the slot of i to the free list
+         *
+         * @param uint32_t i
+         * @return void
+         */
+        void release(uint32_t i);
+
+        /**
+         * Sets the left child of i, and the parent of the child
+         *
+         * @param uint32_t i
+         * @param uint32_t child
+         * @return void
+         */
+        void setLeftChild(uint32_t i, uint32_t child);
+
+        /**
+         * Sets the right child of i, and the parent of the child
+         *
+         * @param uint32_t i
+         * @param uint32_t child
+         * @return void
+         */
+        void setRightChild(uint32_t i, uint32_t child);
+
+        /**
+         * Recomputes the height and size of i from its children
+         *
+         * @param uint32_t i
+         * @return void
+         */
+        void updateNode(uint32_t i);
+
+        /**
+         * Rotates the tree rooted at i to the left, returns the new root
+         *
+         * @param uint32_t i
+         * @return uint32_t
+         */
+        uint32_t rotateLeft(uint32_t i);
+
+        /**
+         * Rotates the tree rooted at i to the right, returns the new root
+         *
+         * @param uint32_t i
+         * @return uint32_t
+         */
+        uint32_t rotateRight(uint32_t i);
+
+        /**
+         * Restores the AVL property at i, returns the new root
+         *
+         * @param uint32_t i
+         * @return uint32_t
+         */
+        uint32_t rebalance(uint32_t i);
+
+        /**
+         * Recursively inserts val into the tree rooted at i, returns the new root
+         *
+         * @param uint32_t i
+         * @param int val
+         * @return uint32_t
+         */
+        uint32_t recursiveInsert(uint32_t i, int val);
+
+        /**
+         * Recursively removes one val from the tree rooted at i, returns the new root
+         *
+         * @param uint32_t i
+         * @param int val
+         * @param bool& removed
+         * @return uint32_t
+         */
+        uint32_t recursiveRemove(uint32_t i, int val, bool& removed);
+
+    public:
+        /**
+         * Creates an empty compact tree
+         */
+        CompactTree();
+
+        /**
+         * Inserts a new value into the tree
+         * Throws once the tree holds COMPACT_MAX_NODES values
+         *
+         * @param int val
+         * @return void
+         */
+        void insert(int val);
+
+        /**
+         * Removes one node holding val, returns whether a node was removed
+         *
+         * @param int val
+         * @return bool
+         */
+        bool remove(int val);
+
+        /**
+         * Checks whether a value exists in the tree
+         *
+         * @param int val
+         * @return bool
+         */
+        bool exists(int val);
+
+        /**
+         * Returns the number of values in the tree
+         *
+         * @return int
+         */
+        int getNumVertices();
+
+        /**
+         * Returns the height of the tree
+         *
+         * @return int
+         */
+        int getHeight();
+
+        /**
+         * Returns the entire tree inOrder
+         *
+         * @return vector<int>
+         */
+        vector<int> inOrder();
+
+        /**
+         * Returns the entire tree levelOrder
+         *
+         * @return vector<vector<int>>
+         */
+        vector<vector<int>> levelOrder();
+
+        /**
+         * Gets the nth value by in order
+         * n must be in the range [1, numVertices]
+         *
+         * @param int n
+         * @return int
+         */
+        int getNthRank(int n);
+
+        /**
+         * Returns the number of bytes held by the node array
+         *
+         * @return size_t
+         */
+        size_t getMemoryUsage();
+
+        /**
+         * Writes the tree to out, the node array goes out in a single write
+         *
+         * @param ostream& out
+         * @return void
+         */
+        void serialize(ostream& out);
+
+        /**
+         * Reads a tree written by serialize
+         * Throws if the input is not a compact tree, or any index is out of the node array
+         *
+         * @param istream& in
+         * @return CompactTree
+         */
+        static CompactTree deserialize(istream& in);
+};
+
+#endif
@@ -0,0 +1,410 @@
+#include "concurrent-binary-search-tree.h"
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * This is an implementation of a concurrent AVL BST by read copy update
+ * A node is fully built before a release store publishes it, and readers
+ * Follow links with acquire loads, so they always see complete nodes
+ *
+ * A new leaf is linked in place. Rotations copy the two or three nodes they
+ * Turn, and a removal of a node with two children copies the path down to
+ * Its successor, which takes its place, so no key a reader is looking for is
+ * Ever out of the tree. The replaced nodes are retired, tagged with the
+ * Current epoch, and freed once every pinned reader announced a later one
+ */
+
+/**
+ * Creates a ConcurrentTreeNode* over the given children
+ *
+ * @param int val
+ * @param ConcurrentTreeNode* left
+ * @param ConcurrentTreeNode* right
+ */
+ConcurrentTreeNode::ConcurrentTreeNode(int val, ConcurrentTreeNode* left, ConcurrentTreeNode* right) : value(val)
+{
+    this->left.store(left, memory_order_relaxed);
+
+    this->right.store(right, memory_order_relaxed);
+
+    this->height = max(left ? left->height : 0, right ? right->height : 0) + 1;
+}
+
+/**
+ * Creates an empty concurrent Binary Search Tree
+ */
+ConcurrentBinarySearchTree::ConcurrentBinarySearchTree()
+{
+    this->size.store(0);
+
+    this->root.store(nullptr);
+}
+
+/**
+ * Frees every node, no thread may still be using the tree
+ */
+ConcurrentBinarySearchTree::~ConcurrentBinarySearchTree()
+{
+    vector<ConcurrentTreeNode*> stack;
+
+    if (this->root.load()) stack.push_back(this->root.load());
+
+    while (!stack.empty())
+    {
+        ConcurrentTreeNode* curr = stack.back();
+
+        stack.pop_back();
+
+        if (curr->left.load()) stack.push_back(curr->left.load());
+
+        if (curr->right.load()) stack.push_back(curr->right.load());
+
+        delete curr;
+    }
+
+    // Retired nodes are out of the tree, so none was met above
+    for (pair<ConcurrentTreeNode*, uint64_t> node : this->retired) delete node.first;
+}
+
+/**
+ * Returns the height of the tree rooted at node
+ *
+ * @param ConcurrentTreeNode* node
+ * @return int
+ */
+int ConcurrentBinarySearchTree::heightOf(ConcurrentTreeNode* node)
+{
+    return node ? node->height : 0;
+}
+
+/**
+ * Points link at node, if it doesn't already
+ *
+ * @param atomic<ConcurrentTreeNode*>& link
+ * @param ConcurrentTreeNode* node
+ * @return void
+ */
+void ConcurrentBinarySearchTree::setLink(atomic<ConcurrentTreeNode*>& link, ConcurrentTreeNode* node)
+{
+    if (link.load(memory_order_relaxed) != node) link.store(node, memory_order_release);
+}
+
+/**
+ * Retires a node that is about to be unlinked
+ * It is tagged with the epoch before the unlink, which is only safer
+ *
+ * @param ConcurrentTreeNode* node
+ * @return void
+ */
+void ConcurrentBinarySearchTree::retire(ConcurrentTreeNode* node)
+{
+    this->retired.push_back(make_pair(node, this->epochs.getEpoch()));
+}
+
+/**
+ * Frees the retired nodes that no pinned reader can still reach
+ * Must be called while holding writerMutex, once the retired nodes are unlinked
+ *
+ * @return void
+ */
+void ConcurrentBinarySearchTree::reclaimRetired()
+{
+    uint64_t oldest = this->epochs.oldestPinned();
+
+    int kept = 0;
+
+    for (size_t i=0; i<this->retired.size(); i++)
+    {
+        if (this->retired[i].second < oldest) delete this->retired[i].first;
+        else this->retired[kept++] = this->retired[i];
+    }
+
+    this->retired.resize(kept);
+}
+
+/**
+ * Returns node, or a rotated copy of it if it breaks the AVL property
+ * The turned nodes are copied and retired, their subtrees are shared
+ *
+ * @param ConcurrentTreeNode* node
+ * @return ConcurrentTreeNode*
+ */
+ConcurrentTreeNode* ConcurrentBinarySearchTree::rebalance(ConcurrentTreeNode* node)
+{
+    ConcurrentTreeNode* left = node->left.load(memory_order_relaxed);
+
+    ConcurrentTreeNode* right = node->right.load(memory_order_relaxed);
+
+    int balance = heightOf(left) - heightOf(right);
+
+    if (balance > 1)
+    {
+        ConcurrentTreeNode* leftLeft = left->left.load(memory_order_relaxed);
+
+        ConcurrentTreeNode* leftRight = left->right.load(memory_order_relaxed);
+
+        this->retire(node);
+
+        this->retire(left);
+
+        // Left left case, a right rotation
+        if (heightOf(leftLeft) >= heightOf(leftRight))
+        {
+            return new ConcurrentTreeNode(left->value, leftLeft, new ConcurrentTreeNode(node->value, leftRight, right));
+        }
+
+        // Left right case, leftRight becomes the root
+        this->retire(leftRight);
+
+        ConcurrentTreeNode* newLeft = new ConcurrentTreeNode(left->value, leftLeft, leftRight->left.load(memory_order_relaxed));
+
+        ConcurrentTreeNode* newRight = new ConcurrentTreeNode(node->value, leftRight->right.load(memory_order_relaxed), right);
+
+        return new ConcurrentTreeNode(leftRight->value, newLeft, newRight);
+    }
+
+    if (balance < -1)
+    {
+        ConcurrentTreeNode* rightLeft = right->left.load(memory_order_relaxed);
+
+        ConcurrentTreeNode* rightRight = right->right.load(memory_order_relaxed);
+
+        this->retire(node);
+
+        this->retire(right);
+
+        // Right right case, a left rotation
+        if (heightOf(rightRight) >= heightOf(rightLeft))
+        {
+            return new ConcurrentTreeNode(right->value, new ConcurrentTreeNode(node->value, left, rightLeft), rightRight);
+        }
+
+        // Right left case, rightLeft becomes the root
+        this->retire(rightLeft);
+
+        ConcurrentTreeNode* newLeft = new ConcurrentTreeNode(node->value, left, rightLeft->left.load(memory_order_relaxed));
+
+        ConcurrentTreeNode* newRight = new ConcurrentTreeNode(right->value, rightLeft->right.load(memory_order_relaxed), rightRight);
+
+        return new ConcurrentTreeNode(rightLeft->value, newLeft, newRight);
+    }
+
+    return node;
+}
+
+/**
+ * Inserts val into the tree rooted at node, returns the new root
+ * The new leaf is linked in place, and the heights on the way up are updated
+ *
+ * @param ConcurrentTreeNode* node
+ * @param int val
+ * @return ConcurrentTreeNode*
+ */
+ConcurrentTreeNode* ConcurrentBinarySearchTree::recursiveInsert(ConcurrentTreeNode* node, int val)
+{
+    if (!node) return new ConcurrentTreeNode(val, nullptr, nullptr);
+
+    atomic<ConcurrentTreeNode*>& link = node->value >= val ? node->left : node->right;
+
+    setLink(link, this->recursiveInsert(link.load(memory_order_relaxed), val));
+
+    node->height = max(heightOf(node->left.load(memory_order_relaxed)), heightOf(node->right.load(memory_order_relaxed))) + 1;
+
+    return this->rebalance(node);
+}
+
+/**
+ * Removes one val from the tree rooted at node, returns the new root
+ * A node with two children is replaced by a copy holding its successor,
+ * Over a copy of the right subtree without the successor
+ *
+ * @param ConcurrentTreeNode* node
+ * @param int val
+ * @param bool& removed
+ * @return ConcurrentTreeNode*
+ */
+ConcurrentTreeNode* ConcurrentBinarySearchTree::recursiveRemove(ConcurrentTreeNode* node, int val, bool& removed)
+{
+    if (!node) return nullptr;
+
+    ConcurrentTreeNode* left = node->left.load(memory_order_relaxed);
+
+    ConcurrentTreeNode* right = node->right.load(memory_order_relaxed);
+
+    if (node->value != val)
+    {
+        atomic<ConcurrentTreeNode*>& link = val < node->value ? node->left : node->right;
+
+        setLink(link, this->recursiveRemove(link.load(memory_order_relaxed), val, removed));
+
+        if (!removed) return node;
+
+        node->height = max(heightOf(node->left.load(memory_order_relaxed)), heightOf(node->right.load(memory_order_relaxed))) + 1;
+
+        return this->rebalance(node);
+    }
+
+    removed = true;
+
+    this->retire(node);
+
+    if (!left) return right;
+
+    if (!right) return left;
+
+    ConcurrentTreeNode* successor = nullptr;
+
+    ConcurrentTreeNode* rest = this->copyWithoutMin(right, successor);
+
+    return this->rebalance(new ConcurrentTreeNode(successor->value, left, rest));
+}
+
+/**
+ * Returns a copy of the tree rooted at node without its smallest node, which goes in min
+ * Only the left spine is copied, the nodes readers can see are left as they are
+ *
+ * @param ConcurrentTreeNode* node
+ * @param ConcurrentTreeNode*& min
+ * @return ConcurrentTreeNode*
+ */
+ConcurrentTreeNode* ConcurrentBinarySearchTree::copyWithoutMin(ConcurrentTreeNode* node, ConcurrentTreeNode*& min)
+{
+    ConcurrentTreeNode* left = node->left.load(memory_order_relaxed);
+
+    ConcurrentTreeNode* right = node->right.load(memory_order_relaxed);
+
+    this->retire(node);
+
+    if (!left)
+    {
+        min = node;
+
+        return right;
+    }
+
+    ConcurrentTreeNode* rest = this->copyWithoutMin(left, min);
+
+    return this->rebalance(new ConcurrentTreeNode(node->value, rest, right));
+}
+
+/**
+ * Inserts a new node into the Binary Search Tree
+ * Safe to call from many threads at once
+ *
+ * @param int val
+ * @return void
+ */
+void ConcurrentBinarySearchTree::insert(int val)
+{
+    lock_guard<mutex> lock(this->writerMutex);
+
+    setLink(this->root, this->recursiveInsert(this->root.load(memory_order_relaxed), val));
+
+    this->size.fetch_add(1, memory_order_relaxed);
+
+    if (this->retired.size() >= RECLAIM_THRESHOLD) this->reclaimRetired();
+}
+
+/**
+ * Removes one node holding val, returns whether there was one
+ * Safe to call from many threads at once
+ *
+ * @param int val
+ * @return bool
+ */
+bool ConcurrentBinarySearchTree::remove(int val)
+{
+    lock_guard<mutex> lock(this->writerMutex);
+
+    bool removed = false;
+
+    setLink(this->root, this->recursiveRemove(this->root.load(memory_order_relaxed), val, removed));
+
+    if (removed) this->size.fetch_sub(1, memory_order_relaxed);
+
+    if (this->retired.size() >= RECLAIM_THRESHOLD) this->reclaimRetired();
+
+    return removed;
+}
+
+/**
+ * Checks whether a value exists in the BST
+ * Lock free, and safe to call while other threads write
+ *
+ * @param int val
+ * @return bool
+ */
+bool ConcurrentBinarySearchTree::exists(int val)
+{
+    EpochGuard guard(this->epochs);
+
+    ConcurrentTreeNode* curr = this->root.load(memory_order_acquire);
+
+    while (curr && curr->value != val)
+    {
+        curr = (curr->value > val ? curr->left : curr->right).load(memory_order_acquire);
+    }
+
+    return curr != nullptr;
+}
+
+/**
+ * Returns the number of vertices in the BST
+ *
+ * @return int
+ */
+int ConcurrentBinarySearchTree::getNumVertices()
+{
+    return this->size.load(memory_order_relaxed);
+}
+
+/**
+ * Returns the height of the BST
+ * Heights belong to the writers, so this waits for the current one
+ *
+ * @return int
+ */
+int ConcurrentBinarySearchTree::getHeight()
+{
+    lock_guard<mutex> lock(this->writerMutex);
+
+    return heightOf(this->root.load(memory_order_relaxed));
+}
+
+/**
+ * Returns the entire tree inOrder
+ * Values written during the walk may be missed, or met twice once moved by a removal
+ *
+ * @return vector<int>
+ */
+vector<int> ConcurrentBinarySearchTree::inOrder()
+{
+    EpochGuard guard(this->epochs);
+
+    vector<int> res;
+
+    vector<ConcurrentTreeNode*> stack;
+
+    ConcurrentTreeNode* curr = this->root.load(memory_order_acquire);
+
+    while (curr || !stack.empty())
+    {
+        while (curr)
+        {
+            stack.push_back(curr);
+
+            curr = curr->left.load(memory_order_acquire);
+        }
+
+        curr = stack.back();
+
+        stack.pop_back();
+
+        res.push_back(curr->value);
+
+        curr = curr->right.load(memory_order_acquire);
+    }
+
+    return res;
+}
@@ -0,0 +1,232 @@
+#ifndef CONCURRENT_BINARY_SEARCH_TREE
+#define CONCURRENT_BINARY_SEARCH_TREE
+
+#include "epoch-reclaimer.cpp"
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+using namespace std;
+
+class ConcurrentTreeNode
+{
+    public:
+        /**
+         * Value held at the node, never changes once the node is published
+         *
+         * @param int value
+         */
+        const int value;
+
+        /**
+         * Height of the tree rooted at this node
+         * Only the writer, holding the tree's mutex, reads or changes it
+         *
+         * @param int height
+         */
+        int height;
+
+        /**
+         * Left child of the node
+         *
+         * @param atomic<ConcurrentTreeNode*> left
+         */
+        atomic<ConcurrentTreeNode*> left;
+
+        /**
+         * Right child of the node
+         *
+         * @param atomic<ConcurrentTreeNode*> right
+         */
+        atomic<ConcurrentTreeNode*> right;
+
+        /**
+         * Creates a ConcurrentTreeNode* over the given children
+         *
+         * @param int val
+         * @param ConcurrentTreeNode* left
+         * @param ConcurrentTreeNode* right
+         */
+        ConcurrentTreeNode(int val, ConcurrentTreeNode* left, ConcurrentTreeNode* right);
+};
+
+/**
+ * AVL Binary Search Tree that many threads can use at once
+ * Readers never lock or retry, writers are serialized by a mutex
+ * A writer never changes a node readers can see, but for linking a child:
+ * Rotations and removals build copies of the nodes they change, and publish
+ * Them with a single store of the link above, so a reader sees either the
+ * Old nodes or the new ones, never a half rotated subtree
+ * Replaced nodes are freed through epoch based reclamation
+ */
+class ConcurrentBinarySearchTree
+{
+    private:
+        /**
+         * Number of elements in the BST
+         *
+         * @param atomic<int> size
+         */
+        atomic<int> size;
+
+        /**
+         * Root of the Binary Search Tree
+         *
+         * @param atomic<ConcurrentTreeNode*> root
+         */
+        atomic<ConcurrentTreeNode*> root;
+
+        /**
+         * Serializes writers, and guards the heights and the retired list
+         *
+         * @param mutex writerMutex
+         */
+        mutex writerMutex;
+
+        /**
+         * Epochs of the pinned readers
+         *
+         * @param EpochReclaimer epochs
+         */
+        EpochReclaimer epochs;
+
+        /**
+         * Replaced nodes waiting for readers to move on, with their retire epoch
+         *
+         * @param vector<pair<ConcurrentTreeNode*, uint64_t>> retired
+         */
+        vector<pair<ConcurrentTreeNode*, uint64_t>> retired;
+
+        /**
+         * Returns the height of the tree rooted at node
+         *
+         * @param ConcurrentTreeNode* node
+         * @return int
+         */
+        static int heightOf(ConcurrentTreeNode* node);
+
+        /**
+         * Points link at node, if it doesn't already
+         *
+         * @param atomic<ConcurrentTreeNode*>& link
+         * @param ConcurrentTreeNode* node
+         * @return void
+         */
+        static void setLink(atomic<ConcurrentTreeNode*>& link, ConcurrentTreeNode* node);
+
+        /**
+         * Retires a node that is about to be unlinked
+         *
+         * @param ConcurrentTreeNode* node
+         * @return void
+         */
+        void retire(ConcurrentTreeNode* node);
+
+        /**
+         * Frees the retired nodes that no pinned reader can still reach
+         * Must be called while holding writerMutex, once the retired nodes are unlinked
+         *
+         * @return void
+         */
+        void reclaimRetired();
+
+        /**
+         * Returns node, or a rotated copy of it if it breaks the AVL property
+         *
+         * @param ConcurrentTreeNode* node
+         * @return ConcurrentTreeNode*
+         */
+        ConcurrentTreeNode* rebalance(ConcurrentTreeNode* node);
+
+        /**
+         * Inserts val into the tree rooted at node, returns the new root
+         *
+         * @param ConcurrentTreeNode* node
+         * @param int val
+         * @return ConcurrentTreeNode*
+         */
+        ConcurrentTreeNode* recursiveInsert(ConcurrentTreeNode* node, int val);
+
+        /**
+         * Removes one val from the tree rooted at node, returns the new root
+         *
+         * @param ConcurrentTreeNode* node
+         * @param int val
+         * @param bool& removed
+         * @return ConcurrentTreeNode*
+         */
+        ConcurrentTreeNode* recursiveRemove(ConcurrentTreeNode* node, int val, bool& removed);
+
+        /**
+         * Returns a copy of the tree rooted at node without its smallest node, which goes in min
+         *
+         * @param ConcurrentTreeNode* node
+         * @param ConcurrentTreeNode*& min
+         * @return ConcurrentTreeNode*
+         */
+        ConcurrentTreeNode* copyWithoutMin(ConcurrentTreeNode* node, ConcurrentTreeNode*& min);
+
+    public:
+        /**
+         * Creates an empty concurrent Binary Search Tree
+         */
+        ConcurrentBinarySearchTree();
+
+        /**
+         * Frees every node, no thread may still be using the tree
+         */
+        ~ConcurrentBinarySearchTree();
+
+        /**
+         * Inserts a new node into the Binary Search Tree
+         * Safe to call from many threads at once
+         *
+         * @param int val
+         * @return void
+         */
+        void insert(int val);
+
+        /**
+         * Removes one node holding val, returns whether there was one
+         * Safe to call from many threads at once
+         *
+         * @param int val
+         * @return bool
+         */
+        bool remove(int val);
+
+        /**
+         * Checks whether a value exists in the BST
+         * Lock free, and safe to call while other threads write
+         *
+         * @param int val
+         * @return bool
+         */
+        bool exists(int val);
+
+        /**
+         * Returns the number of vertices in the BST
+         *
+         * @return int
+         */
+        int getNumVertices();
+
+        /**
+         * Returns the height of the BST
+         *
+         * @return int
+         */
+        int getHeight();
+
+        /**
+         * Returns the entire tree inOrder
+         * Values written during the walk may be missed, or met twice once moved by a removal
+         *
+         * @return vector<int>
+         */
+        vector<int> inOrder();
+};
+
+#endif
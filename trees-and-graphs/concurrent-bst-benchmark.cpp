@@ -0,0 +1,123 @@
+#include "concurrent-binary-search-tree.cpp"
+#include "binary-search-tree.cpp"
+#include <vector>
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <string>
+
+using namespace std;
+
+/**
+ * Read scaling of the concurrent AVL BST against an AVL BST behind one mutex
+ * Every thread runs the same read / write mix over random keys, half of the
+ * Writes insert and half remove, so the trees keep about the same size
+ *
+ * Usage: ./concurrent-bst-benchmark [numKeys] [opsPerThread] [maxThreads]
+ *
+ * @see concurrent-binary-search-tree.cpp
+ * @see binary-search-tree.cpp
+ */
+
+/**
+ * Runs op on numThreads threads, opsPerThread times each, and returns the ops per second
+ * op gets the thread's random generator and whether to read, and returns a hit count
+ *
+ * @param int numThreads
+ * @param int opsPerThread
+ * @param int readPercent
+ * @param Op op
+ * @return double
+ */
+template <class Op>
+double runThreads(int numThreads, int opsPerThread, int readPercent, Op op)
+{
+    vector<thread> threads;
+
+    // Hits are summed, so that lookups can't be optimized away
+    atomic<long long> hits(0);
+
+    auto start = chrono::steady_clock::now();
+
+    for (int t=0; t<numThreads; t++)
+    {
+        threads.push_back(thread([=, &hits]() {
+            mt19937 rng(1000 + t);
+
+            long long threadHits = 0;
+
+            for (int i=0; i<opsPerThread; i++) threadHits += op(rng, (int) (rng() % 100) < readPercent);
+
+            hits += threadHits;
+        }));
+    }
+
+    for (thread& t : threads) t.join();
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    if (hits.load() < 0) cout << "No hits" << endl;
+
+    return (double) numThreads * opsPerThread / seconds;
+}
+
+int main(int argc, char** argv)
+{
+    int numKeys = argc > 1 ? stoi(argv[1]) : 1000000;
+
+    int opsPerThread = argc > 2 ? stoi(argv[2]) : 1000000;
+
+    int maxThreads = argc > 3 ? stoi(argv[3]) : max(1, (int) thread::hardware_concurrency());
+
+    for (int readPercent : {90, 99})
+    {
+        for (int numThreads=1; numThreads<=maxThreads; numThreads*=2)
+        {
+            ConcurrentBinarySearchTree concurrent = ConcurrentBinarySearchTree();
+
+            BinarySearchTree bst = BinarySearchTree(BalanceMode::AVL);
+
+            mutex bstMutex;
+
+            mt19937 rng(42);
+
+            for (int i=0; i<numKeys; i++)
+            {
+                int val = rng() % (2 * numKeys);
+
+                concurrent.insert(val);
+
+                bst.insert(val);
+            }
+
+            double concurrentOps = runThreads(numThreads, opsPerThread, readPercent, [&](mt19937& gen, bool read) {
+                int val = gen() % (2 * numKeys);
+
+                if (read) return (int) concurrent.exists(val);
+
+                if (gen() % 2) concurrent.insert(val);
+                else concurrent.remove(val);
+
+                return 0;
+            });
+
+            double lockedOps = runThreads(numThreads, opsPerThread, readPercent, [&](mt19937& gen, bool read) {
+                int val = gen() % (2 * numKeys);
+
+                lock_guard<mutex> lock(bstMutex);
+
+                if (read) return (int) bst.exists(val);
+
+                if (gen() % 2) bst.insert(val);
+                else bst.remove(val);
+
+                return 0;
+            });
+
+            printf("%d/%d reads/writes threads=%-3d concurrent AVL %12.0f ops/s   mutex + AVL %12.0f ops/s\n",
+                readPercent, 100 - readPercent, numThreads, concurrentOps, lockedOps);
+        }
+    }
+}
@@ -1,4 +1,7 @@
 #include "directed-graph.h"
+#include <vector>
+#include <utility>
+#include <algorithm>
 
 using namespace std;
 
@@ -6,6 +9,70 @@ using namespace std;
  * This is an implementation of a directed graph
  */
 
+/**
+ * Creates a view of [first, last)
+ *
+ * @param const int* first
+ * @param const int* last
+ */
+NeighborRange::NeighborRange(const int* first, const int* last)
+{
+    this->first = first;
+
+    this->last = last;
+}
+
+/**
+ * Returns a pointer to the first neighbor
+ *
+ * @return const int*
+ */
+const int* NeighborRange::begin() const
+{
+    return this->first;
+}
+
+/**
+ * Returns a pointer one past the last neighbor
+ *
+ * @return const int*
+ */
+const int* NeighborRange::end() const
+{
+    return this->last;
+}
+
+/**
+ * Returns the number of neighbors
+ *
+ * @return int
+ */
+int NeighborRange::size() const
+{
+    return this->last - this->first;
+}
+
+/**
+ * Returns whether there are no neighbors
+ *
+ * @return bool
+ */
+bool NeighborRange::empty() const
+{
+    return this->first == this->last;
+}
+
+/**
+ * Returns the ith neighbor
+ *
+ * @param int i
+ * @return int
+ */
+int NeighborRange::operator[](int i) const
+{
+    return this->first[i];
+}
+
 /**
  * Creates a digraph with V edges with no edges
  *
@@ -15,7 +82,13 @@ DirectedGraph::DirectedGraph(int v)
 {
     this->V = v;
 
-    this->adj.resize(v, vector<int>());
+    this->offsets.assign(v + 1, 0);
+
+    this->finalized = true;
+
+    this->reverseOffsets.assign(v + 1, 0);
+
+    this->reverseBuilt = true;
 }
 
 /**
@@ -37,7 +110,9 @@ bool DirectedGraph::isVertexValid(int v)
  */
 void DirectedGraph::addEdges(vector<vector<int>>& edges)
 {
-    for (vector<int> edge : edges)
+    this->edgeList.reserve(this->edgeList.size() + edges.size());
+
+    for (vector<int>& edge : edges)
     {
         this->addEdge(edge[0], edge[1]);
     }
@@ -45,6 +120,7 @@ void DirectedGraph::addEdges(vector<vector<int>>& edges)
 
 /**
  * Adds a directed edge from vertex u to vertex v
+ * A finalized graph goes back to builder mode first, in O(V + E)
  *
  * @param int u
  * @param int v
@@ -55,20 +131,148 @@ void DirectedGraph::addEdge(int u, int v)
     // Disallow self loops by default
     if (!isVertexValid(u) || !isVertexValid(v) || u == v) return;
 
-    this->adj[u].push_back(v);
+    if (this->finalized && !this->targets.empty())
+    {
+        this->edgeList.reserve(this->targets.size() + 1);
+
+        for (int w=0; w<this->V; w++)
+        {
+            for (int i=this->offsets[w]; i<this->offsets[w+1]; i++) this->edgeList.push_back({w, this->targets[i]});
+        }
+
+        this->targets.clear();
+
+        this->targets.shrink_to_fit();
+    }
+
+    this->finalized = false;
+
+    if (this->reverseBuilt)
+    {
+        vector<int>().swap(this->sources);
+
+        this->reverseBuilt = false;
+    }
+
+    this->edgeList.push_back({u, v});
+}
+
+/**
+ * Converts the edge list into CSR form, in O(V + E)
+ * A counting sort by source, which keeps the edges of a vertex in the order they were added
+ *
+ * @return void
+ */
+void DirectedGraph::finalize()
+{
+    if (this->finalized) return;
+
+    this->offsets.assign(this->V + 1, 0);
+
+    for (pair<int, int>& edge : this->edgeList) this->offsets[edge.first + 1]++;
+
+    for (int u=0; u<this->V; u++) this->offsets[u+1] += this->offsets[u];
+
+    this->targets.resize(this->edgeList.size());
+
+    vector<int> next(this->offsets.begin(), this->offsets.end() - 1);
+
+    for (pair<int, int>& edge : this->edgeList) this->targets[next[edge.first]++] = edge.second;
+
+    // The edge list is the larger of the two forms, so it is released
+    vector<pair<int, int>>().swap(this->edgeList);
+
+    this->finalized = true;
+}
+
+/**
+ * Returns whether the edges are in CSR form
+ *
+ * @return bool
+ */
+bool DirectedGraph::isFinalized()
+{
+    return this->finalized;
+}
+
+/**
+ * Returns a view of the out neighbors of vertex u, in O(1)
+ * Finalizes the graph first if needed
+ *
+ * @param int u
+ * @return NeighborRange
+ */
+NeighborRange DirectedGraph::neighbors(int u)
+{
+    if (!this->finalized) this->finalize();
+
+    if (!isVertexValid(u)) return NeighborRange(nullptr, nullptr);
+
+    const int* base = this->targets.data();
+
+    return NeighborRange(base + this->offsets[u], base + this->offsets[u+1]);
+}
+
+/**
+ * Builds the reverse CSR from the CSR, in O(V + E)
+ * Sources of every vertex come in increasing order
+ *
+ * @return void
+ */
+void DirectedGraph::buildReverse()
+{
+    if (!this->finalized) this->finalize();
+
+    if (this->reverseBuilt) return;
+
+    this->reverseOffsets.assign(this->V + 1, 0);
+
+    for (int v : this->targets) this->reverseOffsets[v + 1]++;
+
+    for (int v=0; v<this->V; v++) this->reverseOffsets[v+1] += this->reverseOffsets[v];
+
+    this->sources.resize(this->targets.size());
+
+    vector<int> next(this->reverseOffsets.begin(), this->reverseOffsets.end() - 1);
+
+    for (int u=0; u<this->V; u++)
+    {
+        for (int i=this->offsets[u]; i<this->offsets[u+1]; i++) this->sources[next[this->targets[i]]++] = u;
+    }
+
+    this->reverseBuilt = true;
+}
+
+/**
+ * Returns a view of the in neighbors of vertex v, in O(1)
+ * Builds the reverse CSR first if needed
+ *
+ * @param int v
+ * @return NeighborRange
+ */
+NeighborRange DirectedGraph::reverseNeighbors(int v)
+{
+    if (!this->reverseBuilt) this->buildReverse();
+
+    if (!isVertexValid(v)) return NeighborRange(nullptr, nullptr);
+
+    const int* base = this->sources.data();
+
+    return NeighborRange(base + this->reverseOffsets[v], base + this->reverseOffsets[v+1]);
 }
 
 /**
  * Returns the adj list of vertex u
+ * Copies the neighbors, neighbors(u) returns a view instead
  *
  * @param int u
  * @return vector<int>
  */
 vector<int> DirectedGraph::getAdjList(int u)
 {
-    if (!isVertexValid(u)) return {};
+    NeighborRange range = this->neighbors(u);
 
-    return this->adj[u];
+    return vector<int>(range.begin(), range.end());
 }
 
 
@@ -81,3 +285,211 @@ int DirectedGraph::getNumVertices()
 {
     return this->V;
 }
+
+/**
+ * Returns the number of edges in the graph
+ *
+ * @return int
+ */
+int DirectedGraph::getNumEdges()
+{
+    return this->finalized ? this->targets.size() : this->edgeList.size();
+}
+
+/**
+ * Labels every vertex with its strongly connected component, in O(V + E)
+ * Tarjan's algorithm, with an explicit stack of (vertex, next edge) frames
+ * In place of the recursion, so long paths can't overflow the call stack
+ * A component is numbered when it is completed, which is after every component
+ * It reaches, so an edge between components goes from a higher to a lower number
+ * Returns the number of components
+ *
+ * @param vector<int>& component
+ * @return int
+ */
+int DirectedGraph::stronglyConnectedComponents(vector<int>& component)
+{
+    this->finalize();
+
+    component.assign(this->V, -1);
+
+    vector<int> index(this->V, -1), low(this->V, 0), stack;
+
+    vector<pair<int, int>> frames;
+
+    int counter = 0, numComponents = 0;
+
+    for (int s=0; s<this->V; s++)
+    {
+        if (index[s] != -1) continue;
+
+        index[s] = low[s] = counter++;
+
+        stack.push_back(s);
+
+        frames.push_back({s, this->offsets[s]});
+
+        while (!frames.empty())
+        {
+            int u = frames.back().first;
+
+            if (frames.back().second < this->offsets[u+1])
+            {
+                int v = this->targets[frames.back().second++];
+
+                if (index[v] == -1)
+                {
+                    index[v] = low[v] = counter++;
+
+                    stack.push_back(v);
+
+                    frames.push_back({v, this->offsets[v]});
+                }
+                else if (component[v] == -1)
+                {
+                    // v is still on the stack, so it is in the component of u
+                    low[u] = min(low[u], index[v]);
+                }
+
+                continue;
+            }
+
+            frames.pop_back();
+
+            if (!frames.empty()) low[frames.back().first] = min(low[frames.back().first], low[u]);
+
+            if (low[u] != index[u]) continue;
+
+            // u is the root of a component, which is everything above it on the stack
+            int w;
+
+            do
+            {
+                w = stack.back();
+
+                stack.pop_back();
+
+                component[w] = numComponents;
+            }
+            while (w != u);
+
+            numComponents++;
+        }
+    }
+
+    return numComponents;
+}
+
+/**
+ * Returns the DAG with one vertex per strongly connected component, in O(V + E)
+ * And labels every vertex with its component
+ * Parallel edges between two components are kept once
+ *
+ * @param vector<int>& component
+ * @return DirectedGraph
+ */
+DirectedGraph DirectedGraph::condensation(vector<int>& component)
+{
+    int numComponents = this->stronglyConnectedComponents(component);
+
+    // Vertices grouped by component, by a counting sort
+    vector<int> start(numComponents + 1, 0), members(this->V);
+
+    for (int v=0; v<this->V; v++) start[component[v] + 1]++;
+
+    for (int c=0; c<numComponents; c++) start[c+1] += start[c];
+
+    vector<int> next(start.begin(), start.end() - 1);
+
+    for (int v=0; v<this->V; v++) members[next[component[v]]++] = v;
+
+    DirectedGraph dag = DirectedGraph(numComponents);
+
+    // Last component that added an edge to each component, to skip parallel edges
+    vector<int> lastSource(numComponents, -1);
+
+    for (int c=0; c<numComponents; c++)
+    {
+        for (int i=start[c]; i<start[c+1]; i++)
+        {
+            for (int v : this->neighbors(members[i]))
+            {
+                int d = component[v];
+
+                if (d == c || lastSource[d] == c) continue;
+
+                lastSource[d] = c;
+
+                dag.addEdge(c, d);
+            }
+        }
+    }
+
+    dag.finalize();
+
+    return dag;
+}
+
+/**
+ * Returns the vertices of every strongly connected component that holds a cycle
+ * Given the component labels of stronglyConnectedComponents
+ * Self loops are never added, so that is every component of more than one vertex
+ *
+ * @param vector<int>& component
+ * @return vector<vector<int>>
+ */
+vector<vector<int>> DirectedGraph::cycles(vector<int>& component)
+{
+    int numComponents = 0;
+
+    for (int c : component) numComponents = max(numComponents, c + 1);
+
+    vector<vector<int>> members(numComponents);
+
+    for (int v=0; v<this->V; v++) members[component[v]].push_back(v);
+
+    vector<vector<int>> res;
+
+    for (vector<int>& group : members)
+    {
+        if (group.size() > 1) res.push_back(group);
+    }
+
+    return res;
+}
+
+/**
+ * Returns the vertices in an order where every edge goes forward, in O(V + E)
+ * Kahn's algorithm, a vertex is output once every vertex with an edge to it was
+ * Throws an error if the graph has a cycle
+ *
+ * @return vector<int>
+ */
+vector<int> DirectedGraph::topologicalSort()
+{
+    this->finalize();
+
+    vector<int> inDegree(this->V, 0), order;
+
+    for (int v : this->targets) inDegree[v]++;
+
+    order.reserve(this->V);
+
+    for (int v=0; v<this->V; v++)
+    {
+        if (inDegree[v] == 0) order.push_back(v);
+    }
+
+    // order doubles as the queue, the vertices after head are ready but not expanded
+    for (size_t head=0; head<order.size(); head++)
+    {
+        for (int v : this->neighbors(order[head]))
+        {
+            if (--inDegree[v] == 0) order.push_back(v);
+        }
+    }
+
+    if ((int) order.size() < this->V) throw "Graph has a cycle";
+
+    return order;
+}
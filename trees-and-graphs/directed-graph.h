@@ -2,9 +2,87 @@
 #define DIRECTED_GRAPH
 
 #include <vector>
+#include <utility>
 
 using namespace std;
 
+/**
+ * Non-owning view of the out neighbors of a vertex, a slice of the CSR targets
+ * Valid until the graph is modified again
+ */
+class NeighborRange
+{
+    private:
+        /**
+         * First neighbor
+         *
+         * @param const int* first
+         */
+        const int* first;
+
+        /**
+         * One past the last neighbor
+         *
+         * @param const int* last
+         */
+        const int* last;
+
+    public:
+        /**
+         * Creates a view of [first, last)
+         *
+         * @param const int* first
+         * @param const int* last
+         */
+        NeighborRange(const int* first, const int* last);
+
+        /**
+         * Returns a pointer to the first neighbor
+         *
+         * @return const int*
+         */
+        const int* begin() const;
+
+        /**
+         * Returns a pointer one past the last neighbor
+         *
+         * @return const int*
+         */
+        const int* end() const;
+
+        /**
+         * Returns the number of neighbors
+         *
+         * @return int
+         */
+        int size() const;
+
+        /**
+         * Returns whether there are no neighbors
+         *
+         * @return bool
+         */
+        bool empty() const;
+
+        /**
+         * Returns the ith neighbor
+         *
+         * @param int i
+         * @return int
+         */
+        int operator[](int i) const;
+};
+
+/**
+ * Directed graph with two modes
+ * In builder mode addEdge appends to an edge list
+ * finalize sorts the edge list by source in O(V + E), into compressed sparse
+ * Row form: the out neighbors of u are targets[offsets[u]..offsets[u+1]),
+ * In the order their edges were added, so a traversal walks one flat array
+ * The reverse CSR, for in neighbors, is only built when first asked for
+ * Reads finalize the graph on first use, call finalize and buildReverse
+ * Before sharing the graph between threads
+ */
 class DirectedGraph
 {
     private:
@@ -16,11 +94,53 @@ class DirectedGraph
         int V;
 
         /**
-         * Adjacency list containing all edges for each vertex
+         * Edges added since the graph was last finalized, as (source, target)
+         *
+         * @param vector<pair<int, int>> edgeList
+         */
+        vector<pair<int, int>> edgeList;
+
+        /**
+         * Whether the edges are in CSR form, rather than in the edge list
+         *
+         * @param bool finalized
+         */
+        bool finalized;
+
+        /**
+         * Start of the neighbors of every vertex in targets, V + 1 entries
+         *
+         * @param vector<int> offsets
+         */
+        vector<int> offsets;
+
+        /**
+         * Out neighbors of every vertex, grouped by vertex
          *
-         * @param vector<vector<int>> adj
+         * @param vector<int> targets
          */
-        vector<vector<int>> adj;
+        vector<int> targets;
+
+        /**
+         * Whether the reverse CSR matches the edges
+         *
+         * @param bool reverseBuilt
+         */
+        bool reverseBuilt;
+
+        /**
+         * Start of the in neighbors of every vertex in sources, V + 1 entries
+         *
+         * @param vector<int> reverseOffsets
+         */
+        vector<int> reverseOffsets;
+
+        /**
+         * In neighbors of every vertex, grouped by vertex
+         *
+         * @param vector<int> sources
+         */
+        vector<int> sources;
 
     public:
         /**
@@ -47,6 +167,43 @@ class DirectedGraph
          */
         void addEdge(int u, int v);
 
+        /**
+         * Converts the edge list into CSR form, in O(V + E)
+         *
+         * @return void
+         */
+        void finalize();
+
+        /**
+         * Returns whether the edges are in CSR form
+         *
+         * @return bool
+         */
+        bool isFinalized();
+
+        /**
+         * Returns a view of the out neighbors of vertex u, in O(1)
+         *
+         * @param int u
+         * @return NeighborRange
+         */
+        NeighborRange neighbors(int u);
+
+        /**
+         * Builds the reverse CSR from the CSR, in O(V + E)
+         *
+         * @return void
+         */
+        void buildReverse();
+
+        /**
+         * Returns a view of the in neighbors of vertex v, in O(1)
+         *
+         * @param int v
+         * @return NeighborRange
+         */
+        NeighborRange reverseNeighbors(int v);
+
         /**
          * Returns the adj list of vertex u
          *
@@ -69,6 +226,48 @@ class DirectedGraph
          * @return int
          */
         int getNumVertices();
+
+        /**
+         * Returns the number of edges in the graph
+         *
+         * @return int
+         */
+        int getNumEdges();
+
+        /**
+         * Labels every vertex with its strongly connected component, in O(V + E)
+         * Returns the number of components
+         *
+         * @param vector<int>& component
+         * @return int
+         */
+        int stronglyConnectedComponents(vector<int>& component);
+
+        /**
+         * Returns the DAG with one vertex per strongly connected component, in O(V + E)
+         * And labels every vertex with its component
+         *
+         * @param vector<int>& component
+         * @return DirectedGraph
+         */
+        DirectedGraph condensation(vector<int>& component);
+
+        /**
+         * Returns the vertices of every strongly connected component that holds a cycle
+         * Given the component labels of stronglyConnectedComponents
+         *
+         * @param vector<int>& component
+         * @return vector<vector<int>>
+         */
+        vector<vector<int>> cycles(vector<int>& component);
+
+        /**
+         * Returns the vertices in an order where every edge goes forward, in O(V + E)
+         * Throws an error if the graph has a cycle
+         *
+         * @return vector<int>
+         */
+        vector<int> topologicalSort();
 };
 
 #endif
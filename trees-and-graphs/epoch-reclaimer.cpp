@@ -0,0 +1,115 @@
+#include "epoch-reclaimer.h"
+
+using namespace std;
+
+/**
+ * This is an implementation of epoch based reclamation
+ * Readers announce the epoch they started in, in a slot of their own, and
+ * Writers advance the epoch before they look for the oldest announcement,
+ * So a reader pinning during the look announces an epoch no node is tagged with
+ */
+
+/**
+ * Creates a reclaimer with no pinned readers
+ */
+EpochReclaimer::EpochReclaimer()
+{
+    // Epoch 0 marks a free reader slot
+    this->globalEpoch.store(1);
+
+    for (int i=0; i<MAX_EPOCH_READERS; i++) this->readerEpochs[i].epoch.store(0);
+}
+
+/**
+ * Claims a reader slot announcing the current epoch, returns the slot
+ * Threads start from the slot they took last, so they rarely meet on one
+ * Spins while all MAX_EPOCH_READERS slots are taken
+ *
+ * @return int
+ */
+int EpochReclaimer::pin()
+{
+    static thread_local int hint = 0;
+
+    for (int i=hint; ; i = (i + 1) % MAX_EPOCH_READERS)
+    {
+        uint64_t epoch = this->globalEpoch.load();
+
+        uint64_t expected = 0;
+
+        if (!this->readerEpochs[i].epoch.compare_exchange_strong(expected, epoch)) continue;
+
+        // A reclaim that missed the announcement has advanced the epoch, so take the new one
+        while (this->globalEpoch.load() != epoch)
+        {
+            epoch = this->globalEpoch.load();
+
+            this->readerEpochs[i].epoch.store(epoch);
+        }
+
+        hint = i;
+
+        return i;
+    }
+}
+
+/**
+ * Frees the reader slot
+ *
+ * @param int slot
+ * @return void
+ */
+void EpochReclaimer::unpin(int slot)
+{
+    this->readerEpochs[slot].epoch.store(0);
+}
+
+/**
+ * Returns the current epoch, which nodes retired now are tagged with
+ *
+ * @return uint64_t
+ */
+uint64_t EpochReclaimer::getEpoch()
+{
+    return this->globalEpoch.load();
+}
+
+/**
+ * Advances the epoch and returns the oldest epoch a reader may still be in
+ * Nodes retired in an earlier epoch can be freed
+ * Must only be called once the retired nodes are unreachable
+ *
+ * @return uint64_t
+ */
+uint64_t EpochReclaimer::oldestPinned()
+{
+    // Readers pinning from now on announce at least the new epoch
+    uint64_t oldest = this->globalEpoch.fetch_add(1) + 1;
+
+    for (int i=0; i<MAX_EPOCH_READERS; i++)
+    {
+        uint64_t epoch = this->readerEpochs[i].epoch.load();
+
+        if (epoch != 0 && epoch < oldest) oldest = epoch;
+    }
+
+    return oldest;
+}
+
+/**
+ * Pins the reader to the current epoch of epochs
+ *
+ * @param EpochReclaimer& epochs
+ */
+EpochGuard::EpochGuard(EpochReclaimer& epochs) : epochs(epochs)
+{
+    this->slot = epochs.pin();
+}
+
+/**
+ * Unpins the reader
+ */
+EpochGuard::~EpochGuard()
+{
+    this->epochs.unpin(this->slot);
+}
@@ -0,0 +1,127 @@
+#ifndef EPOCH_RECLAIMER
+#define EPOCH_RECLAIMER
+
+#include <atomic>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * Maximum number of readers that can be pinned at the same time
+ */
+const int MAX_EPOCH_READERS = 128;
+
+/**
+ * Number of retired nodes that triggers an attempt to free them
+ */
+const int RECLAIM_THRESHOLD = 1024;
+
+class EpochSlot
+{
+    public:
+        /**
+         * Epoch announced by the reader holding the slot, 0 for a free slot
+         * Slots sit on their own cache line, so pinned readers don't share one
+         *
+         * @param atomic<uint64_t> epoch
+         */
+        alignas(64) atomic<uint64_t> epoch;
+};
+
+/**
+ * Epochs of the readers of a lock free structure, whose writers retire nodes
+ * A node is tagged with the epoch it was retired in, once it is unreachable
+ * From the structure, and can be freed once every pinned reader announced a
+ * Later epoch, as such readers started after the node became unreachable
+ * Writers keep their own retired lists and free them through oldestPinned
+ */
+class EpochReclaimer
+{
+    private:
+        /**
+         * Global epoch, advanced on every reclamation attempt
+         *
+         * @param atomic<uint64_t> globalEpoch
+         */
+        atomic<uint64_t> globalEpoch;
+
+        /**
+         * Epoch announced by each pinned reader
+         *
+         * @param EpochSlot readerEpochs[]
+         */
+        EpochSlot readerEpochs[MAX_EPOCH_READERS];
+
+    public:
+        /**
+         * Creates a reclaimer with no pinned readers
+         */
+        EpochReclaimer();
+
+        /**
+         * Claims a reader slot announcing the current epoch, returns the slot
+         *
+         * @return int
+         */
+        int pin();
+
+        /**
+         * Frees the reader slot
+         *
+         * @param int slot
+         * @return void
+         */
+        void unpin(int slot);
+
+        /**
+         * Returns the current epoch, which nodes retired now are tagged with
+         *
+         * @return uint64_t
+         */
+        uint64_t getEpoch();
+
+        /**
+         * Advances the epoch and returns the oldest epoch a reader may still be in
+         * Nodes retired in an earlier epoch can be freed
+         *
+         * @return uint64_t
+         */
+        uint64_t oldestPinned();
+};
+
+/**
+ * Pins the calling reader to the current epoch for its lifetime
+ * Nodes reachable when the guard was created won't be freed until it goes away
+ */
+class EpochGuard
+{
+    private:
+        /**
+         * Reclaimer the reader is pinned to
+         *
+         * @param EpochReclaimer& epochs
+         */
+        EpochReclaimer& epochs;
+
+        /**
+         * Reader slot held by this guard
+         *
+         * @param int slot
+         */
+        int slot;
+
+    public:
+        /**
+         * Pins the reader to the current epoch of epochs
+         *
+         * @param EpochReclaimer& epochs
+         */
+        EpochGuard(EpochReclaimer& epochs);
+
+        /**
+         * Unpins the reader
+         */
+        ~EpochGuard();
+};
+
+#endif
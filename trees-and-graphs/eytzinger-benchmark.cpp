@@ -0,0 +1,105 @@
+#include "binary-search-tree.cpp"
+#include <vector>
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <string>
+
+using namespace std;
+
+/**
+ * Compares lookups in the pointer based AVL tree against its frozen snapshot
+ * Half of the queried keys are present in the tree
+ * Memory of the pointer tree excludes the allocator overhead per node
+ *
+ * Usage: ./eytzinger-benchmark [numKeys...]
+ *
+ * @see binary-search-tree.cpp
+ * @see eytzinger-tree.cpp
+ */
+
+/**
+ * Returns the queries per second of numQueries queries run since start
+ *
+ * @param chrono::steady_clock::time_point start
+ * @param int numQueries
+ * @return double
+ */
+double queriesPerSecond(chrono::steady_clock::time_point start, int numQueries)
+{
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    return numQueries / seconds;
+}
+
+/**
+ * Builds both trees with n keys and prints their lookup rate and memory
+ *
+ * @param int n
+ * @param int numQueries
+ * @return void
+ */
+void runBenchmark(int n, int numQueries)
+{
+    BinarySearchTree bst = BinarySearchTree(BalanceMode::AVL);
+
+    for (int i=0; i<n; i++) bst.insert(2*i);
+
+    EytzingerTree frozen = bst.freeze();
+
+    mt19937 rng(42);
+
+    vector<int> queries(numQueries);
+
+    for (int& q : queries) q = rng() % (2 * n);
+
+    auto start = chrono::steady_clock::now();
+
+    int found = 0;
+
+    for (int q : queries) found += bst.exists(q);
+
+    double pointerQps = queriesPerSecond(start, numQueries);
+
+    start = chrono::steady_clock::now();
+
+    int frozenFound = 0;
+
+    for (int q : queries) frozenFound += frozen.exists(q);
+
+    double frozenQps = queriesPerSecond(start, numQueries);
+
+    start = chrono::steady_clock::now();
+
+    long long checksum = 0;
+
+    for (int q : queries)
+    {
+        int res;
+
+        if (frozen.lowerBound(q, res)) checksum += res;
+    }
+
+    double lowerBoundQps = queriesPerSecond(start, numQueries);
+
+    double pointerMb = (double) n * sizeof(TreeNode) / (1 << 20);
+
+    double frozenMb = (double) frozen.getMemoryUsage() / (1 << 20);
+
+    printf("n=%-10d pointer exists %12.0f q/s %9.1fMB | eytzinger exists %12.0f q/s lower bound %12.0f q/s %9.1fMB | found %d/%d checksum %lld\n",
+        n, pointerQps, pointerMb, frozenQps, lowerBoundQps, frozenMb, found, frozenFound, checksum);
+}
+
+int main(int argc, char** argv)
+{
+    int numQueries = 2000000;
+
+    if (argc == 1)
+    {
+        runBenchmark(1000000, numQueries);
+
+        return 0;
+    }
+
+    for (int i=1; i<argc; i++) runBenchmark(stoi(argv[i]), numQueries);
+}
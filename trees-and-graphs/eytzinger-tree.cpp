@@ -0,0 +1,123 @@
+#include "eytzinger-tree.h"
+
+using namespace std;
+
+/**
+ * This is an implementation of a read only BST snapshot in Eytzinger layout
+ * The top levels of the tree share cache lines, and the search loop
+ * Has no data dependent branches, so lookups can be prefetched ahead
+ */
+
+/**
+ * Creates a snapshot from values sorted in increasing order
+ *
+ * @param vector<int>& sorted
+ */
+EytzingerTree::EytzingerTree(vector<int>& sorted)
+{
+    this->size = sorted.size();
+
+    this->values.resize(this->size + 1);
+
+    this->build(sorted, 0, 1);
+}
+
+/**
+ * Fills the Eytzinger array from the sorted values
+ * An in order walk over the implicit tree visits the slots in sorted order
+ *
+ * @param vector<int>& sorted
+ * @param size_t i
+ * @param size_t k
+ * @return size_t
+ */
+size_t EytzingerTree::build(vector<int>& sorted, size_t i, size_t k)
+{
+    if (k > this->size) return i;
+
+    i = this->build(sorted, i, 2*k);
+
+    this->values[k] = sorted[i++];
+
+    return this->build(sorted, i, 2*k+1);
+}
+
+/**
+ * Returns the Eytzinger index of the first value >= val
+ * Returns 0 if every value is < val
+ * Indices are size_t, as 16k overflows an int once there are over 2^27 values
+ *
+ * @param int val
+ * @return size_t
+ */
+size_t EytzingerTree::lowerBoundIndex(int val)
+{
+    const int* data = this->values.data();
+
+    size_t k = 1;
+
+    while (k <= this->size)
+    {
+        // The 16 descendants four levels down share one cache line
+        __builtin_prefetch(data + 16*k);
+
+        k = 2*k + (data[k] < val);
+    }
+
+    // Undo the right turns taken after the last left turn
+    k >>= __builtin_ffsll(~k);
+
+    return k;
+}
+
+/**
+ * Checks whether a value exists in the snapshot
+ *
+ * @param int val
+ * @return bool
+ */
+bool EytzingerTree::exists(int val)
+{
+    size_t k = this->lowerBoundIndex(val);
+
+    return k != 0 && this->values[k] == val;
+}
+
+/**
+ * Finds the smallest value >= val
+ * Returns false if there is no such value
+ *
+ * @param int val
+ * @param int& res
+ * @return bool
+ */
+bool EytzingerTree::lowerBound(int val, int& res)
+{
+    size_t k = this->lowerBoundIndex(val);
+
+    if (k == 0) return false;
+
+    res = this->values[k];
+
+    return true;
+}
+
+/**
+ * Returns the number of values in the snapshot
+ *
+ * @return int
+ */
+int EytzingerTree::getNumVertices()
+{
+    return (int) this->size;
+}
+
+/**
+ * Returns the number of bytes held by the snapshot
+ *
+ * @return size_t
+ */
+size_t EytzingerTree::getMemoryUsage()
+{
+    return sizeof(EytzingerTree) + this->values.capacity() * sizeof(int);
+}
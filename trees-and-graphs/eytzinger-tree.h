@@ -0,0 +1,91 @@
+#ifndef EYTZINGER_TREE
+#define EYTZINGER_TREE
+
+#include <vector>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * Immutable snapshot of a Binary Search Tree in Eytzinger (BFS) layout
+ * Node k has its children at 2k and 2k+1, all held in one contiguous array
+ */
+class EytzingerTree
+{
+    private:
+        /**
+         * Number of values in the snapshot
+         *
+         * @param size_t size
+         */
+        size_t size;
+
+        /**
+         * Values in Eytzinger order, index 0 is unused
+         *
+         * @param vector<int> values
+         */
+        vector<int> values;
+
+        /**
+         * Fills the Eytzinger array from the sorted values
+         * Returns the index of the next sorted value to place
+         *
+         * @param vector<int>& sorted
+         * @param size_t i
+         * @param size_t k
+         * @return size_t
+         */
+        size_t build(vector<int>& sorted, size_t i, size_t k);
+
+        /**
+         * Returns the Eytzinger index of the first value >= val
+         * Returns 0 if every value is < val
+         *
+         * @param int val
+         * @return size_t
+         */
+        size_t lowerBoundIndex(int val);
+
+    public:
+        /**
+         * Creates a snapshot from values sorted in increasing order
+         *
+         * @param vector<int>& sorted
+         */
+        EytzingerTree(vector<int>& sorted);
+
+        /**
+         * Checks whether a value exists in the snapshot
+         *
+         * @param int val
+         * @return bool
+         */
+        bool exists(int val);
+
+        /**
+         * Finds the smallest value >= val
+         * Returns false if there is no such value
+         *
+         * @param int val
+         * @param int& res
+         * @return bool
+         */
+        bool lowerBound(int val, int& res);
+
+        /**
+         * Returns the number of values in the snapshot
+         *
+         * @return int
+         */
+        int getNumVertices();
+
+        /**
+         * Returns the number of bytes held by the snapshot
+         *
+         * @return size_t
+         */
+        size_t getMemoryUsage();
+};
+
+#endif
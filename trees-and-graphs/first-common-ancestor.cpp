@@ -1,4 +1,5 @@
 #include "binary-search-tree.cpp"
+#include "lca-index.cpp"
 #include <vector>
 #include <iostream>
 #include <list>
@@ -7,44 +8,12 @@ using namespace std;
 
 /**
  * Write an algorithm to find the first common ancestor in a binary tree
+ * For many queries against a fixed tree, LcaIndex answers each one in O(1)
  *
  * @see binary-search-tree.cpp
+ * @see lca-index.cpp
  */
 
-/**
- * Creates a tree of minimal height
- *
- * @param BinarySearchTree& bst
- * @param vectorint>& v
- * @param int start
- * @param int end
- * @return void
- */
-void minimalTree(BinarySearchTree& bst, vector<int>& v, int start, int end)
-{
-    if (start > end) return;
-
-    int mid = (start + end) / 2;
-
-    bst.insert(v[mid]);
-
-    minimalTree(bst, v, start, mid-1);
-
-    minimalTree(bst, v, mid+1, end);
-}
-
-/**
- * Creates a tree of minimal height
- *
- * @param BinarySearchTree& bst
- * @param vectorint>& v
- * @return void
- */
-void minimalTree(BinarySearchTree& bst, vector<int>& v)
-{
-    minimalTree(bst, v, 0, v.size()-1);
-}
-
 /**
  * Start from n, go upwards
  *
@@ -96,7 +65,7 @@ int main()
 
     cout << endl;
 
-    minimalTree(bst, v);
+    bst.bulkLoad(v);
 
     cout << endl;
 
@@ -153,4 +122,26 @@ int main()
     printf("Checking if 8 is an ancestor of 15 : %d\n", isAncestorOf);
 
     cout << endl;
+
+    LcaIndex index = LcaIndex(bst.getRoot());
+
+    vector<pair<TreeNode*, TreeNode*>> queries;
+
+    vector<pair<int, int>> ranks = {{3, 7}, {1, 15}, {4, 7}, {7, 4}, {11, 15}, {8, 15}};
+
+    for (pair<int, int> p : ranks)
+    {
+        queries.push_back(make_pair(bst.getNthRank(p.first), bst.getNthRank(p.second)));
+    }
+
+    vector<TreeNode*> lcas = index.lca(queries);
+
+    vector<bool> ancestors = index.isAncestorOf(queries);
+
+    for (size_t i=0; i<queries.size(); i++)
+    {
+        printf("Indexed LCA of %d, %d is %d, is %d an ancestor of %d : %d\n",
+            ranks[i].first, ranks[i].second, lcas[i]->getValue(),
+            ranks[i].first, ranks[i].second, (int) ancestors[i]);
+    }
 }
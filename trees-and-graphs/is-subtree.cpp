@@ -11,40 +11,6 @@ using namespace std;
  * @see binary-search-tree.cpp
  */
 
-/**
- * Creates a tree of minimal height
- *
- * @param BinarySearchTree& bst
- * @param vectorint>& v
- * @param int start
- * @param int end
- * @return void
- */
-void minimalTree(BinarySearchTree& bst, vector<int>& v, int start, int end)
-{
-    if (start > end) return;
-
-    int mid = (start + end) / 2;
-
-    bst.insert(v[mid]);
-
-    minimalTree(bst, v, start, mid-1);
-
-    minimalTree(bst, v, mid+1, end);
-}
-
-/**
- * Creates a tree of minimal height
- *
- * @param BinarySearchTree& bst
- * @param vectorint>& v
- * @return void
- */
-void minimalTree(BinarySearchTree& bst, vector<int>& v)
-{
-    minimalTree(bst, v, 0, v.size()-1);
-}
-
 int main()
 {
     BinarySearchTree bst = BinarySearchTree();
@@ -55,7 +21,7 @@ int main()
 
     cout << endl;
 
-    minimalTree(bst, v);
+    bst.bulkLoad(v);
 
     cout << endl;
 
@@ -71,7 +37,7 @@ int main()
 
     printf("The height of the tree before insertion %d\n", bst2.getHeight());
 
-    minimalTree(bst2, v);
+    bst2.bulkLoad(v);
 
     cout << endl;
 
@@ -93,11 +59,24 @@ int main()
 
     printf("The height of the tree before insertion %d\n", bst2.getHeight());
 
-    minimalTree(bst2, v);
+    bst2.bulkLoad(v);
 
     printf("The height of the tree after insertion %d\n", bst2.getHeight());
 
     cout << endl;
 
     printf("Checking if T2 is a subtree of T1 %d\n", bst.isSubtree(bst2.getRoot()));
+
+    cout << endl;
+
+    // bst2 holds 9..15, the right subtree of bst
+    vector<BinarySearchTree*> forest = {&bst, &bst2};
+
+    vector<vector<TreeNode*>> duplicates = BinarySearchTree::findDuplicateSubtrees(forest, 3);
+
+    for (vector<TreeNode*>& group : duplicates)
+    {
+        printf("Subtree rooted at %d of size %d appears %zu times\n",
+            group[0]->getValue(), group[0]->getSize(), group.size());
+    }
 }
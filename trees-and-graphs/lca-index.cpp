@@ -0,0 +1,224 @@
+#include "lca-index.h"
+
+using namespace std;
+
+/**
+ * This is an implementation of an LCA index over a fixed binary tree
+ * Nodes are numbered in pre order, so the subtree of u is a range of ids
+ * For u < v, not an ancestor of v, the shallowest node in (u, v] is the
+ * Child of lca(u, v) on the path to v, so lca is the parent of that node
+ */
+
+/**
+ * Builds the index over the tree rooted at root in O(n log n)
+ *
+ * @param TreeNode* root
+ */
+LcaIndex::LcaIndex(TreeNode* root)
+{
+    // Explicit stack, so deep trees can't overflow the call stack
+    vector<pair<TreeNode*, int>> stack;
+
+    if (root) stack.push_back(make_pair(root, -1));
+
+    while (!stack.empty())
+    {
+        pair<TreeNode*, int> p = stack.back();
+
+        stack.pop_back();
+
+        int id = this->nodes.size();
+
+        this->nodes.push_back(p.first);
+
+        this->ids[p.first] = id;
+
+        this->parent.push_back(p.second);
+
+        this->depth.push_back(p.second < 0 ? 0 : this->depth[p.second] + 1);
+
+        if (p.first->right) stack.push_back(make_pair(p.first->right, id));
+
+        if (p.first->left) stack.push_back(make_pair(p.first->left, id));
+    }
+
+    this->n = this->nodes.size();
+
+    // Children have larger ids than their parent, so sizes add up backwards
+    vector<int> size(this->n, 1);
+
+    for (int id=this->n-1; id>0; id--) size[this->parent[id]] += size[id];
+
+    this->last.resize(this->n);
+
+    for (int id=0; id<this->n; id++) this->last[id] = id + size[id] - 1;
+
+    this->logs.assign(this->n + 1, 0);
+
+    for (int len=2; len<=this->n; len++) this->logs[len] = this->logs[len/2] + 1;
+
+    int levels = this->n > 0 ? this->logs[this->n] + 1 : 0;
+
+    this->sparse.resize((size_t) levels * this->n);
+
+    for (int i=0; i<this->n; i++) this->sparse[i] = i;
+
+    for (int k=1; k<levels; k++)
+    {
+        int half = 1 << (k-1);
+
+        int* prev = &this->sparse[(size_t) (k-1) * this->n];
+
+        int* curr = &this->sparse[(size_t) k * this->n];
+
+        for (int i=0; i + 2*half <= this->n; i++)
+        {
+            curr[i] = this->shallower(prev[i], prev[i + half]);
+        }
+    }
+}
+
+/**
+ * Returns the shallower of two node ids
+ *
+ * @param int u
+ * @param int v
+ * @return int
+ */
+int LcaIndex::shallower(int u, int v)
+{
+    return this->depth[u] <= this->depth[v] ? u : v;
+}
+
+/**
+ * Returns the id of node, -1 if the node isn't in the tree
+ *
+ * @param TreeNode* node
+ * @return int
+ */
+int LcaIndex::getId(TreeNode* node)
+{
+    unordered_map<TreeNode*, int>::iterator it = this->ids.find(node);
+
+    return it != this->ids.end() ? it->second : -1;
+}
+
+/**
+ * Returns the node with the given id
+ *
+ * @param int id
+ * @return TreeNode*
+ */
+TreeNode* LcaIndex::getNode(int id)
+{
+    return id >= 0 && id < this->n ? this->nodes[id] : nullptr;
+}
+
+/**
+ * Returns whether node u is an ancestor of node v, by id
+ * Every node is an ancestor of itself
+ *
+ * @param int u
+ * @param int v
+ * @return bool
+ */
+bool LcaIndex::isAncestorOf(int u, int v)
+{
+    return u <= v && v <= this->last[u];
+}
+
+/**
+ * Returns whether node u is an ancestor of node v
+ *
+ * @param TreeNode* u
+ * @param TreeNode* v
+ * @return bool
+ */
+bool LcaIndex::isAncestorOf(TreeNode* u, TreeNode* v)
+{
+    int idU = this->getId(u);
+
+    int idV = this->getId(v);
+
+    if (idU < 0 || idV < 0) return false;
+
+    return this->isAncestorOf(idU, idV);
+}
+
+/**
+ * Returns the id of the lowest common ancestor of u and v, by id
+ *
+ * @param int u
+ * @param int v
+ * @return int
+ */
+int LcaIndex::lca(int u, int v)
+{
+    if (u == v) return u;
+
+    if (u > v) swap(u, v);
+
+    // Shallowest node in the id range (u, v]
+    int k = this->logs[v - u];
+
+    int* level = &this->sparse[(size_t) k * this->n];
+
+    int shallowest = this->shallower(level[u + 1], level[v - (1 << k) + 1]);
+
+    return this->parent[shallowest];
+}
+
+/**
+ * Returns the lowest common ancestor of u and v
+ * Returns nullptr if either node isn't in the tree
+ *
+ * @param TreeNode* u
+ * @param TreeNode* v
+ * @return TreeNode*
+ */
+TreeNode* LcaIndex::lca(TreeNode* u, TreeNode* v)
+{
+    int idU = this->getId(u);
+
+    int idV = this->getId(v);
+
+    if (idU < 0 || idV < 0) return nullptr;
+
+    return this->nodes[this->lca(idU, idV)];
+}
+
+/**
+ * Answers a batch of LCA queries
+ *
+ * @param vector<pair<TreeNode*, TreeNode*>>& queries
+ * @return vector<TreeNode*>
+ */
+vector<TreeNode*> LcaIndex::lca(vector<pair<TreeNode*, TreeNode*>>& queries)
+{
+    vector<TreeNode*> res(queries.size());
+
+    for (size_t i=0; i<queries.size(); i++)
+    {
+        res[i] = this->lca(queries[i].first, queries[i].second);
+    }
+
+    return res;
+}
+
+/**
+ * Answers a batch of ancestor queries, first is tested as ancestor of second
+ *
+ * @param vector<pair<TreeNode*, TreeNode*>>& queries
+ * @return vector<bool>
+ */
+vector<bool> LcaIndex::isAncestorOf(vector<pair<TreeNode*, TreeNode*>>& queries)
+{
+    vector<bool> res(queries.size());
+
+    for (size_t i=0; i<queries.size(); i++)
+    {
+        res[i] = this->isAncestorOf(queries[i].first, queries[i].second);
+    }
+
+    return res;
+}
@@ -0,0 +1,166 @@
+#ifndef LCA_INDEX
+#define LCA_INDEX
+
+#include "tree-node.h"
+#include <vector>
+#include <utility>
+#include <unordered_map>
+
+using namespace std;
+
+/**
+ * Preprocessed index over a fixed tree for ancestor and LCA queries
+ * Ancestor tests compare DFS entry / exit numbers in O(1)
+ * LCA queries are a range minimum query over the DFS order in O(1)
+ * The tree must not change after the index is built
+ */
+class LcaIndex
+{
+    private:
+        /**
+         * Number of nodes in the tree
+         *
+         * @param int n
+         */
+        int n;
+
+        /**
+         * Nodes of the tree in pre order, the position is the node id
+         *
+         * @param vector<TreeNode*> nodes
+         */
+        vector<TreeNode*> nodes;
+
+        /**
+         * Id of every node of the tree
+         *
+         * @param unordered_map<TreeNode*, int> ids
+         */
+        unordered_map<TreeNode*, int> ids;
+
+        /**
+         * Id of the parent of every node, -1 for the root
+         *
+         * @param vector<int> parent
+         */
+        vector<int> parent;
+
+        /**
+         * Depth of every node, 0 for the root
+         *
+         * @param vector<int> depth
+         */
+        vector<int> depth;
+
+        /**
+         * Id of the last node of the subtree of every node
+         * The subtree of u holds the ids [u, last[u]]
+         *
+         * @param vector<int> last
+         */
+        vector<int> last;
+
+        /**
+         * Sparse table of the shallowest node id in [i, i + 2^k)
+         * Level k starts at k * n
+         *
+         * @param vector<int> sparse
+         */
+        vector<int> sparse;
+
+        /**
+         * Floor of log2 of every range length up to n
+         *
+         * @param vector<int> logs
+         */
+        vector<int> logs;
+
+        /**
+         * Returns the shallower of two node ids
+         *
+         * @param int u
+         * @param int v
+         * @return int
+         */
+        int shallower(int u, int v);
+
+    public:
+        /**
+         * Builds the index over the tree rooted at root in O(n log n)
+         *
+         * @param TreeNode* root
+         */
+        LcaIndex(TreeNode* root);
+
+        /**
+         * Returns the id of node, -1 if the node isn't in the tree
+         *
+         * @param TreeNode* node
+         * @return int
+         */
+        int getId(TreeNode* node);
+
+        /**
+         * Returns the node with the given id
+         *
+         * @param int id
+         * @return TreeNode*
+         */
+        TreeNode* getNode(int id);
+
+        /**
+         * Returns whether node u is an ancestor of node v, by id
+         * Every node is an ancestor of itself
+         *
+         * @param int u
+         * @param int v
+         * @return bool
+         */
+        bool isAncestorOf(int u, int v);
+
+        /**
+         * Returns whether node u is an ancestor of node v
+         *
+         * @param TreeNode* u
+         * @param TreeNode* v
+         * @return bool
+         */
+        bool isAncestorOf(TreeNode* u, TreeNode* v);
+
+        /**
+         * Returns the id of the lowest common ancestor of u and v, by id
+         *
+         * @param int u
+         * @param int v
+         * @return int
+         */
+        int lca(int u, int v);
+
+        /**
+         * Returns the lowest common ancestor of u and v
+         * Returns nullptr if either node isn't in the tree
+         *
+         * @param TreeNode* u
+         * @param TreeNode* v
+         * @return TreeNode*
+         */
+        TreeNode* lca(TreeNode* u, TreeNode* v);
+
+        /**
+         * Answers a batch of LCA queries
+         *
+         * @param vector<pair<TreeNode*, TreeNode*>>& queries
+         * @return vector<TreeNode*>
+         */
+        vector<TreeNode*> lca(vector<pair<TreeNode*, TreeNode*>>& queries);
+
+        /**
+         * Answers a batch of ancestor queries, first is tested as ancestor of second
+         *
+         * @param vector<pair<TreeNode*, TreeNode*>>& queries
+         * @return vector<bool>
+         */
+        vector<bool> isAncestorOf(vector<pair<TreeNode*, TreeNode*>>& queries);
+};
+
+#endif
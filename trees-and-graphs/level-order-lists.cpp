@@ -12,40 +12,6 @@ using namespace std;
  * @see binary-search-tree.cpp
  */
 
-/**
- * Creates a tree of minimal height
- *
- * @param BinarySearchTree& bst
- * @param vectorint>& v
- * @param int start
- * @param int end
- * @return void
- */
-void minimalTree(BinarySearchTree& bst, vector<int>& v, int start, int end)
-{
-    if (start > end) return;
-
-    int mid = (start + end) / 2;
-
-    bst.insert(v[mid]);
-
-    minimalTree(bst, v, start, mid-1);
-
-    minimalTree(bst, v, mid+1, end);
-}
-
-/**
- * Creates a tree of minimal height
- *
- * @param BinarySearchTree& bst
- * @param vectorint>& v
- * @return void
- */
-void minimalTree(BinarySearchTree& bst, vector<int>& v)
-{
-    minimalTree(bst, v, 0, v.size()-1);
-}
-
 int main()
 {
     BinarySearchTree bst = BinarySearchTree();
@@ -55,7 +21,7 @@ int main()
     // 15 elements held in 4 levels
     cout << bst.getHeight() << endl;
 
-    minimalTree(bst, v);
+    bst.bulkLoad(v);
 
     bst.printTree();
 
@@ -67,19 +33,50 @@ int main()
 
     cout << endl;
 
-    vector<list> res = bst.levelOrderLists();
+    vector<list<int>> res = bst.levelOrderLists();
 
     int level = 0;
 
-    for (list l : res)
+    for (list<int> l : res)
     {
-        printf("Currently printing level %d\n", level);
+        printf("Currently printing level %d\n", level++);
 
-        for (list::iterator it = l.begin(); it != l.end(); it++)
+        for (list<int>::iterator it = l.begin(); it != l.end(); it++)
         {
             cout << *it << " ";
         }
 
         cout << endl;
     }
+
+    cout << endl;
+
+    // Same levels, held in flat buffers that can be reused across calls
+    vector<int> values;
+
+    vector<int> levelStarts;
+
+    bst.levelOrder(values, levelStarts);
+
+    for (level=0; level+1<(int) levelStarts.size(); level++)
+    {
+        printf("Currently printing flat level %d\n", level);
+
+        for (int i=levelStarts[level]; i<levelStarts[level+1]; i++)
+        {
+            cout << values[i] << " ";
+        }
+
+        cout << endl;
+    }
+
+    cout << endl;
+
+    cout << "Streaming the tree in pre order" << endl;
+
+    PreOrderIterator it = bst.preOrderIterator();
+
+    while (it.hasNext()) cout << it.next() << " ";
+
+    cout << endl;
 }
@@ -0,0 +1,123 @@
+#include "binary-search-tree.cpp"
+#include <vector>
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <string>
+
+using namespace std;
+
+/**
+ * Moves key ranges between two AVL Binary Search Trees, as between two shards
+ * split, merge and eraseRange read the trees in order and relink the nodes
+ * Into a balanced tree, so they are O(n) with no per key insert or remove
+ *
+ * Usage: ./merge-split [numKeys]
+ *
+ * @see binary-search-tree.cpp
+ */
+
+/**
+ * Returns the milliseconds elapsed since start
+ *
+ * @param chrono::steady_clock::time_point start
+ * @return double
+ */
+double elapsedMs(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Prints the values of the tree in order
+ *
+ * @param string name
+ * @param BinarySearchTree& bst
+ * @return void
+ */
+void printValues(string name, BinarySearchTree& bst)
+{
+    printf("%s:", name.c_str());
+
+    for (int val : bst.inOrder()) printf(" %d", val);
+
+    printf(" (height %d, balanced %d)\n", bst.getHeight(), bst.getBalanced());
+}
+
+int main(int argc, char** argv)
+{
+    BinarySearchTree shardA = BinarySearchTree(BalanceMode::AVL);
+
+    BinarySearchTree shardB = BinarySearchTree(BalanceMode::AVL);
+
+    for (int val : {1, 3, 5, 7, 9, 11, 13}) shardA.insert(val);
+
+    for (int val : {2, 4, 6, 8, 10}) shardB.insert(val);
+
+    printValues("Shard A", shardA);
+
+    printValues("Shard B", shardB);
+
+    cout << endl;
+
+    shardA.merge(shardB);
+
+    printValues("Shard A after merging shard B", shardA);
+
+    printValues("Shard B after merging shard B", shardB);
+
+    cout << endl;
+
+    shardB = shardA.split(6);
+
+    printValues("Shard A after splitting at 6", shardA);
+
+    printValues("Shard B after splitting at 6", shardB);
+
+    cout << endl;
+
+    int removed = shardB.eraseRange(8, 11);
+
+    printf("Erased %d values in [8, 11]\n", removed);
+
+    printValues("Shard B", shardB);
+
+    cout << endl;
+
+    int numKeys = argc > 1 ? stoi(argv[1]) : 1000000;
+
+    mt19937 rng(42);
+
+    BinarySearchTree big = BinarySearchTree(BalanceMode::AVL);
+
+    BinarySearchTree other = BinarySearchTree(BalanceMode::AVL);
+
+    for (int i=0; i<numKeys; i++)
+    {
+        big.insert(rng() % (10 * numKeys));
+
+        other.insert(rng() % (10 * numKeys));
+    }
+
+    auto start = chrono::steady_clock::now();
+
+    big.merge(other);
+
+    double mergeMs = elapsedMs(start);
+
+    start = chrono::steady_clock::now();
+
+    BinarySearchTree upper = big.split(5 * numKeys);
+
+    double splitMs = elapsedMs(start);
+
+    start = chrono::steady_clock::now();
+
+    removed = big.eraseRange(numKeys, 2 * numKeys);
+
+    double eraseMs = elapsedMs(start);
+
+    printf("merge of 2 x %d keys: %.2fms, split: %.2fms (%d / %d), eraseRange: %.2fms (%d removed), audit %d %d\n",
+        numKeys, mergeMs, splitMs, big.getNumVertices() + removed, upper.getNumVertices(), eraseMs, removed,
+        big.audit(), upper.audit());
+}
@@ -7,6 +7,7 @@ using namespace std;
 /**
  * Write an algorithm to build a BST of minimal height
  * If you are given a sorted array, with unique elements
+ * BinarySearchTree::bulkLoad builds the same tree in O(n) without inserts
  */
 
 /**
@@ -61,4 +62,12 @@ int main()
     cout << endl;
 
     bst.printLevelOrder();
+
+    cout << endl;
+
+    BinarySearchTree loaded = BinarySearchTree();
+
+    loaded.bulkLoad(v);
+
+    loaded.printLevelOrder();
 }
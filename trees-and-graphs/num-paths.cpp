@@ -10,40 +10,6 @@ using namespace std;
  * @see binary-search-tree.cpp
  */
 
-/**
- * Creates a tree of minimal height
- *
- * @param BinarySearchTree& bst
- * @param vectorint>& v
- * @param int start
- * @param int end
- * @return void
- */
-void minimalTree(BinarySearchTree& bst, vector<int>& v, int start, int end)
-{
-    if (start > end) return;
-
-    int mid = (start + end) / 2;
-
-    bst.insert(v[mid]);
-
-    minimalTree(bst, v, start, mid-1);
-
-    minimalTree(bst, v, mid+1, end);
-}
-
-/**
- * Creates a tree of minimal height
- *
- * @param BinarySearchTree& bst
- * @param vectorint>& v
- * @return void
- */
-void minimalTree(BinarySearchTree& bst, vector<int>& v)
-{
-    minimalTree(bst, v, 0, v.size()-1);
-}
-
 int main()
 {
     BinarySearchTree bst = BinarySearchTree();
@@ -54,7 +20,7 @@ int main()
 
     cout << endl;
 
-    minimalTree(bst, v);
+    bst.bulkLoad(v);
 
     cout << endl;
 
@@ -65,4 +31,18 @@ int main()
     cout << endl;
 
     printf("Number of paths that sum to 6 %d\n", bst.numPaths(6));
+
+    cout << endl;
+
+    // Several sums in one traversal, then the same split across threads
+    vector<int> ks = {6, 10, 15};
+
+    vector<long long> counts = bst.numPaths(ks);
+
+    vector<long long> parallelCounts = bst.numPaths(ks, 4);
+
+    for (size_t i=0; i<ks.size(); i++)
+    {
+        printf("Number of paths that sum to %d %lld, in parallel %lld\n", ks[i], counts[i], parallelCounts[i]);
+    }
 }
@@ -0,0 +1,80 @@
+#include "binary-search-tree.cpp"
+#include <vector>
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <string>
+
+using namespace std;
+
+/**
+ * Order statistic queries on an AVL Binary Search Tree
+ * Every node stores the size and the sum of its subtree
+ * So nth rank, rank of a value and range count / sum are O(log n)
+ *
+ * Usage: ./order-statistics [numKeys] [numQueries]
+ *
+ * @see binary-search-tree.cpp
+ */
+
+int main(int argc, char** argv)
+{
+    BinarySearchTree bst = BinarySearchTree(BalanceMode::AVL);
+
+    vector<int> v = {5, 1, 4, 4, 5, 9, 7, 13, 3};
+
+    for (int elem : v) bst.insert(elem);
+
+    bst.printTree();
+
+    cout << endl;
+
+    for (int i=1; i<=bst.getNumVertices(); i++)
+    {
+        printf("Node of rank %d is %d\n", i, bst.getNthRank(i)->getValue());
+    }
+
+    cout << endl;
+
+    for (int elem : {0, 4, 5, 6, 13, 20})
+    {
+        printf("Rank of %d is %d\n", elem, bst.rankOf(elem));
+    }
+
+    cout << endl;
+
+    printf("Number of values in [4, 9] is %d\n", bst.rangeCount(4, 9));
+
+    printf("Sum of the values in [4, 9] is %lld\n", bst.rangeSum(4, 9));
+
+    cout << endl;
+
+    int numKeys = argc > 1 ? stoi(argv[1]) : 1000000;
+
+    int numQueries = argc > 2 ? stoi(argv[2]) : 1000000;
+
+    mt19937 rng(42);
+
+    bst.clear();
+
+    for (int i=0; i<numKeys; i++) bst.insert(rng() % (10 * numKeys));
+
+    auto start = chrono::steady_clock::now();
+
+    long long checksum = 0;
+
+    for (int i=0; i<numQueries; i++)
+    {
+        // Percentile lookup, followed by the reverse rank lookup
+        int n = 1 + rng() % bst.getNumVertices();
+
+        int val = bst.getNthRank(n)->getValue();
+
+        checksum += bst.rankOf(val);
+    }
+
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    printf("%d percentile + rank queries on %d keys took %.2fms (%.0f queries/s, checksum %lld)\n",
+        numQueries, numKeys, ms, 2000.0 * numQueries / ms, checksum);
+}
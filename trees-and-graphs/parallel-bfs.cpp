@@ -0,0 +1,405 @@
+#include "parallel-bfs.h"
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * Creates a search over graph, which uses up to numThreads threads
+ *
+ * @param DirectedGraph& graph
+ * @param int numThreads
+ */
+ParallelBfs::ParallelBfs(DirectedGraph& graph, int numThreads)
+{
+    this->graph = &graph;
+
+    this->numThreads = numThreads < 1 ? 1 : numThreads;
+
+    this->visited = vector<atomic<uint64_t>>((graph.getNumVertices() + 63) / 64);
+
+    this->directionOptimizing = false;
+
+    this->topDownSteps = 0;
+
+    this->bottomUpSteps = 0;
+
+    this->edgesExamined = 0;
+}
+
+/**
+ * Runs fn(thread, lo, hi) over [0, n) in chunks, on numThreads threads
+ * Threads take the next chunk as they finish one, so uneven chunks even out
+ *
+ * @param int n
+ * @param int chunk
+ * @param function<void(int, int, int)> fn
+ * @return void
+ */
+void ParallelBfs::forEachChunk(int n, int chunk, function<void(int, int, int)> fn)
+{
+    atomic<int> nextChunk(0);
+
+    auto work = [&](int t) {
+        for (int lo = nextChunk.fetch_add(chunk); lo < n; lo = nextChunk.fetch_add(chunk))
+        {
+            fn(t, lo, min(n, lo + chunk));
+        }
+    };
+
+    int threads = min(this->numThreads, (n + chunk - 1) / chunk);
+
+    vector<thread> pool;
+
+    for (int t=1; t<threads; t++) pool.push_back(thread(work, t));
+
+    work(0);
+
+    for (thread& th : pool) th.join();
+}
+
+/**
+ * Visits the unvisited out neighbors of frontier, into next
+ * A vertex belongs to the thread whose fetch_or sets its visited bit
+ * Returns the number of vertices visited, and adds their out and in degrees
+ *
+ * @param vector<int>& frontier
+ * @param vector<int>& next
+ * @param int depth
+ * @param long long& outDegrees
+ * @param long long& inDegrees
+ * @return long long
+ */
+long long ParallelBfs::topDownStep(vector<int>& frontier, vector<int>& next, int depth, long long& outDegrees, long long& inDegrees)
+{
+    vector<vector<int>> local(this->numThreads);
+
+    atomic<long long> outSum(0), inSum(0);
+
+    this->forEachChunk(frontier.size(), BFS_TOP_DOWN_CHUNK, [&](int t, int lo, int hi) {
+        long long examined = 0, out = 0, in = 0;
+
+        for (int i=lo; i<hi; i++)
+        {
+            int u = frontier[i];
+
+            for (int v : this->graph->neighbors(u))
+            {
+                examined++;
+
+                uint64_t bit = 1ULL << (v & 63);
+
+                // Plain load first, most edges of a dense level lead to visited vertices
+                if (this->visited[v >> 6].load(memory_order_relaxed) & bit) continue;
+
+                if (this->visited[v >> 6].fetch_or(bit, memory_order_relaxed) & bit) continue;
+
+                this->parents[v] = u;
+
+                this->distances[v] = depth + 1;
+
+                local[t].push_back(v);
+
+                out += this->graph->neighbors(v).size();
+
+                if (this->directionOptimizing) in += this->graph->reverseNeighbors(v).size();
+            }
+        }
+
+        this->edgesExamined += examined;
+
+        outSum += out;
+
+        inSum += in;
+    });
+
+    next.clear();
+
+    for (vector<int>& part : local) next.insert(next.end(), part.begin(), part.end());
+
+    outDegrees += outSum;
+
+    inDegrees += inSum;
+
+    return next.size();
+}
+
+/**
+ * Visits every unvisited vertex with an in neighbor in frontier, into next
+ * Threads own whole words of the bitmaps, so no bit is contended
+ * Returns the number of vertices visited, and adds their out and in degrees
+ *
+ * @param vector<uint64_t>& frontier
+ * @param vector<uint64_t>& next
+ * @param int depth
+ * @param long long& outDegrees
+ * @param long long& inDegrees
+ * @return long long
+ */
+long long ParallelBfs::bottomUpStep(vector<uint64_t>& frontier, vector<uint64_t>& next, int depth, long long& outDegrees, long long& inDegrees)
+{
+    atomic<long long> count(0), outSum(0), inSum(0);
+
+    next.resize(frontier.size());
+
+    this->forEachChunk(frontier.size(), BFS_BOTTOM_UP_CHUNK, [&](int /*t*/, int lo, int hi) {
+        long long examined = 0, found = 0, out = 0, in = 0;
+
+        for (int w=lo; w<hi; w++)
+        {
+            uint64_t seen = this->visited[w].load(memory_order_relaxed);
+
+            uint64_t reached = 0;
+
+            for (uint64_t todo = ~seen; todo; todo &= todo - 1)
+            {
+                int v = (w << 6) + __builtin_ctzll(todo);
+
+                NeighborRange candidates = this->graph->reverseNeighbors(v);
+
+                for (int u : candidates)
+                {
+                    examined++;
+
+                    if (!((frontier[u >> 6] >> (u & 63)) & 1)) continue;
+
+                    this->parents[v] = u;
+
+                    this->distances[v] = depth + 1;
+
+                    reached |= todo & -todo;
+
+                    found++;
+
+                    out += this->graph->neighbors(v).size();
+
+                    in += candidates.size();
+
+                    break;
+                }
+            }
+
+            next[w] = reached;
+
+            if (reached) this->visited[w].store(seen | reached, memory_order_relaxed);
+        }
+
+        this->edgesExamined += examined;
+
+        count += found;
+
+        outSum += out;
+
+        inSum += in;
+    });
+
+    outDegrees += outSum;
+
+    inDegrees += inSum;
+
+    return count;
+}
+
+/**
+ * Runs a direction optimizing search from source
+ *
+ * @param int source
+ * @return void
+ */
+void ParallelBfs::run(int source)
+{
+    this->run(source, true);
+}
+
+/**
+ * Runs a search from source, top down only unless directionOptimizing
+ * Before every level the cheaper direction is picked: bottom up once the out
+ * Edges of the frontier exceed 1 / BFS_ALPHA of the in edges of the unvisited
+ * Vertices, and top down again once the frontier shrinks below 1 / BFS_BETA of V
+ *
+ * @param int source
+ * @param bool directionOptimizing
+ * @return void
+ */
+void ParallelBfs::run(int source, bool directionOptimizing)
+{
+    int n = this->graph->getNumVertices();
+
+    int words = (n + 63) / 64;
+
+    // Both CSRs are built here, as the threads only read them
+    this->graph->finalize();
+
+    if (directionOptimizing) this->graph->buildReverse();
+
+    this->directionOptimizing = directionOptimizing;
+
+    this->distances.assign(n, -1);
+
+    this->parents.assign(n, -1);
+
+    for (int w=0; w<words; w++) this->visited[w] = 0;
+
+    // Bits past the last vertex count as visited, so bottom up steps skip them
+    if (n & 63) this->visited[words-1] = ~0ULL << (n & 63);
+
+    this->topDownSteps = 0;
+
+    this->bottomUpSteps = 0;
+
+    this->edgesExamined = 0;
+
+    if (!this->graph->isVertexValid(source)) return;
+
+    this->visited[source >> 6] |= 1ULL << (source & 63);
+
+    this->distances[source] = 0;
+
+    this->parents[source] = source;
+
+    vector<int> frontier = {source}, nextFrontier;
+
+    vector<uint64_t> frontierBits, nextBits;
+
+    bool bottomUp = false;
+
+    long long frontierSize = 1, previousSize = 0;
+
+    long long frontierEdges = this->graph->neighbors(source).size();
+
+    long long unexploredEdges = 0;
+
+    if (directionOptimizing) unexploredEdges = this->graph->getNumEdges() - this->graph->reverseNeighbors(source).size();
+
+    for (int depth=0; frontierSize > 0; depth++)
+    {
+        if (directionOptimizing && !bottomUp && frontierEdges > unexploredEdges / BFS_ALPHA)
+        {
+            frontierBits.assign(words, 0);
+
+            for (int v : frontier) frontierBits[v >> 6] |= 1ULL << (v & 63);
+
+            bottomUp = true;
+        }
+        else if (bottomUp && frontierSize < n / BFS_BETA && frontierSize < previousSize)
+        {
+            frontier.clear();
+
+            for (int w=0; w<words; w++)
+            {
+                for (uint64_t bits = frontierBits[w]; bits; bits &= bits - 1) frontier.push_back((w << 6) + __builtin_ctzll(bits));
+            }
+
+            bottomUp = false;
+        }
+
+        previousSize = frontierSize;
+
+        long long outDegrees = 0, inDegrees = 0;
+
+        if (bottomUp)
+        {
+            frontierSize = this->bottomUpStep(frontierBits, nextBits, depth, outDegrees, inDegrees);
+
+            swap(frontierBits, nextBits);
+
+            this->bottomUpSteps++;
+        }
+        else
+        {
+            frontierSize = this->topDownStep(frontier, nextFrontier, depth, outDegrees, inDegrees);
+
+            swap(frontier, nextFrontier);
+
+            this->topDownSteps++;
+        }
+
+        frontierEdges = outDegrees;
+
+        unexploredEdges -= inDegrees;
+    }
+}
+
+/**
+ * Returns whether v was reached by the last search
+ *
+ * @param int v
+ * @return bool
+ */
+bool ParallelBfs::isReached(int v)
+{
+    return this->graph->isVertexValid(v) && this->distances[v] >= 0;
+}
+
+/**
+ * Returns the distance of every vertex from the last source, -1 if unreached
+ *
+ * @return vector<int>&
+ */
+vector<int>& ParallelBfs::getDistances()
+{
+    return this->distances;
+}
+
+/**
+ * Returns the BFS tree parent of every vertex, -1 if unreached
+ *
+ * @return vector<int>&
+ */
+vector<int>& ParallelBfs::getParents()
+{
+    return this->parents;
+}
+
+/**
+ * Returns a shortest path from the last source to v, empty if v is unreached
+ *
+ * @param int v
+ * @return vector<int>
+ */
+vector<int> ParallelBfs::getPath(int v)
+{
+    vector<int> path;
+
+    if (!this->isReached(v)) return path;
+
+    for (; this->parents[v] != v; v = this->parents[v]) path.push_back(v);
+
+    path.push_back(v);
+
+    reverse(path.begin(), path.end());
+
+    return path;
+}
+
+/**
+ * Returns the number of levels run top down by the last search
+ *
+ * @return int
+ */
+int ParallelBfs::getTopDownSteps()
+{
+    return this->topDownSteps;
+}
+
+/**
+ * Returns the number of levels run bottom up by the last search
+ *
+ * @return int
+ */
+int ParallelBfs::getBottomUpSteps()
+{
+    return this->bottomUpSteps;
+}
+
+/**
+ * Returns the number of edges examined by the last search
+ *
+ * @return long long
+ */
+long long ParallelBfs::getEdgesExamined()
+{
+    return this->edgesExamined;
+}
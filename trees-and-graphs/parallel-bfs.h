@@ -0,0 +1,222 @@
+#ifndef PARALLEL_BFS
+#define PARALLEL_BFS
+
+#include "directed-graph.h"
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+using namespace std;
+
+/**
+ * Switch to bottom up once the frontier has more than 1 / BFS_ALPHA of the unexplored edges
+ */
+const int BFS_ALPHA = 14;
+
+/**
+ * Switch back to top down once a shrinking frontier has fewer than 1 / BFS_BETA of the vertices
+ */
+const int BFS_BETA = 24;
+
+/**
+ * Number of frontier vertices a thread takes at a time in a top down step
+ */
+const int BFS_TOP_DOWN_CHUNK = 256;
+
+/**
+ * Number of 64 vertex words a thread takes at a time in a bottom up step
+ */
+const int BFS_BOTTOM_UP_CHUNK = 64;
+
+/**
+ * Direction optimizing breadth first search (Beamer, Asanovic, Patterson)
+ * Every level is one parallel step over the frontier, with a bitmap of visited
+ * Vertices, so a vertex is claimed by exactly one thread and enqueued once
+ * Top down steps scan the out edges of the frontier
+ * Bottom up steps scan the in edges of every unvisited vertex, and stop at the
+ * First parent found in the frontier, which is far cheaper once the frontier
+ * Holds a large part of the graph
+ * Records the distance and the BFS tree parent of every vertex reached
+ */
+class ParallelBfs
+{
+    private:
+        /**
+         * Graph being searched
+         *
+         * @param DirectedGraph* graph
+         */
+        DirectedGraph* graph;
+
+        /**
+         * Number of threads per step
+         *
+         * @param int numThreads
+         */
+        int numThreads;
+
+        /**
+         * Number of edges from the source to every vertex, -1 if unreached
+         *
+         * @param vector<int> distances
+         */
+        vector<int> distances;
+
+        /**
+         * Parent of every vertex in the BFS tree, the source is its own parent, -1 if unreached
+         *
+         * @param vector<int> parents
+         */
+        vector<int> parents;
+
+        /**
+         * One bit per vertex, set once the vertex is reached
+         *
+         * @param vector<atomic<uint64_t>> visited
+         */
+        vector<atomic<uint64_t>> visited;
+
+        /**
+         * Whether the last search could switch to bottom up steps
+         *
+         * @param bool directionOptimizing
+         */
+        bool directionOptimizing;
+
+        /**
+         * Number of levels run top down by the last search
+         *
+         * @param int topDownSteps
+         */
+        int topDownSteps;
+
+        /**
+         * Number of levels run bottom up by the last search
+         *
+         * @param int bottomUpSteps
+         */
+        int bottomUpSteps;
+
+        /**
+         * Number of edges examined by the last search
+         *
+         * @param atomic<long long> edgesExamined
+         */
+        atomic<long long> edgesExamined;
+
+        /**
+         * Runs fn(thread, lo, hi) over [0, n) in chunks, on numThreads threads
+         *
+         * @param int n
+         * @param int chunk
+         * @param function<void(int, int, int)> fn
+         * @return void
+         */
+        void forEachChunk(int n, int chunk, function<void(int, int, int)> fn);
+
+        /**
+         * Visits the unvisited out neighbors of frontier, into next
+         * Returns the number of vertices visited, and adds their out and in degrees
+         *
+         * @param vector<int>& frontier
+         * @param vector<int>& next
+         * @param int depth
+         * @param long long& outDegrees
+         * @param long long& inDegrees
+         * @return long long
+         */
+        long long topDownStep(vector<int>& frontier, vector<int>& next, int depth, long long& outDegrees, long long& inDegrees);
+
+        /**
+         * Visits every unvisited vertex with an in neighbor in frontier, into next
+         * Returns the number of vertices visited, and adds their out and in degrees
+         *
+         * @param vector<uint64_t>& frontier
+         * @param vector<uint64_t>& next
+         * @param int depth
+         * @param long long& outDegrees
+         * @param long long& inDegrees
+         * @return long long
+         */
+        long long bottomUpStep(vector<uint64_t>& frontier, vector<uint64_t>& next, int depth, long long& outDegrees, long long& inDegrees);
+
+    public:
+        /**
+         * Creates a search over graph, which uses up to numThreads threads
+         *
+         * @param DirectedGraph& graph
+         * @param int numThreads
+         */
+        ParallelBfs(DirectedGraph& graph, int numThreads);
+
+        /**
+         * Runs a direction optimizing search from source
+         *
+         * @param int source
+         * @return void
+         */
+        void run(int source);
+
+        /**
+         * Runs a search from source, top down only unless directionOptimizing
+         *
+         * @param int source
+         * @param bool directionOptimizing
+         * @return void
+         */
+        void run(int source, bool directionOptimizing);
+
+        /**
+         * Returns whether v was reached by the last search
+         *
+         * @param int v
+         * @return bool
+         */
+        bool isReached(int v);
+
+        /**
+         * Returns the distance of every vertex from the last source, -1 if unreached
+         *
+         * @return vector<int>&
+         */
+        vector<int>& getDistances();
+
+        /**
+         * Returns the BFS tree parent of every vertex, -1 if unreached
+         *
+         * @return vector<int>&
+         */
+        vector<int>& getParents();
+
+        /**
+         * Returns a shortest path from the last source to v, empty if v is unreached
+         *
+         * @param int v
+         * @return vector<int>
+         */
+        vector<int> getPath(int v);
+
+        /**
+         * Returns the number of levels run top down by the last search
+         *
+         * @return int
+         */
+        int getTopDownSteps();
+
+        /**
+         * Returns the number of levels run bottom up by the last search
+         *
+         * @return int
+         */
+        int getBottomUpSteps();
+
+        /**
+         * Returns the number of edges examined by the last search
+         *
+         * @return long long
+         */
+        long long getEdgesExamined();
+};
+
+#endif
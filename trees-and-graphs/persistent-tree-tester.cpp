@@ -0,0 +1,143 @@
+#include "persistent-tree.cpp"
+#include <vector>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <string>
+
+using namespace std;
+
+/**
+ * Checks that versions of the persistent tree never change once published
+ * One writer inserts random keys while readers pin the newest version, or
+ * Hold snapshots across many inserts, and check what they read stays the same
+ * Then all versions but the newest are released and their nodes reclaimed
+ *
+ * Usage: ./persistent-tree-tester [numKeys] [numReaders]
+ *
+ * @see persistent-tree.cpp
+ */
+
+/**
+ * Checks that version holds a sorted sequence of the expected length
+ *
+ * @param PersistentNode* version
+ * @param int expected
+ * @return bool
+ */
+bool checkVersion(PersistentNode* version, int expected)
+{
+    vector<int> values = PersistentTree::inOrder(version);
+
+    return (int) values.size() == expected && is_sorted(values.begin(), values.end());
+}
+
+int main(int argc, char** argv)
+{
+    int numKeys = argc > 1 ? stoi(argv[1]) : 200000;
+
+    int numReaders = argc > 2 ? stoi(argv[2]) : 3;
+
+    PersistentTree tree = PersistentTree();
+
+    mt19937 rng(42);
+
+    vector<int> keys(numKeys);
+
+    for (int i=0; i<numKeys; i++) keys[i] = rng() % numKeys;
+
+    tree.insert(keys[0]);
+
+    tree.insert(keys[1]);
+
+    atomic<bool> done(false);
+
+    atomic<long long> reads(0);
+
+    atomic<bool> consistent(true);
+
+    vector<thread> readers;
+
+    for (int r=0; r<numReaders; r++)
+    {
+        readers.push_back(thread([&tree, &done, &reads, &consistent, &keys, r]() {
+            mt19937 rng(1000 + r);
+
+            while (!done.load())
+            {
+                if (r % 2 == 0)
+                {
+                    // Lock free reads of the newest version
+                    EpochGuard guard(tree.getEpochs());
+
+                    PersistentNode* version = tree.getLatest();
+
+                    int size = PersistentTree::getNumVertices(version);
+
+                    for (int i=0; i<1000; i++)
+                    {
+                        if (!PersistentTree::exists(version, keys[rng() % size])) consistent = false;
+                    }
+
+                    if (PersistentTree::getNumVertices(version) != size) consistent = false;
+                }
+                else
+                {
+                    // A snapshot reads the same values while the writer moves on
+                    PersistentNode* version = tree.snapshot();
+
+                    int size = PersistentTree::getNumVertices(version);
+
+                    if (!checkVersion(version, size)) consistent = false;
+
+                    this_thread::yield();
+
+                    if (!checkVersion(version, size)) consistent = false;
+
+                    tree.release(version);
+                }
+
+                reads++;
+            }
+        }));
+    }
+
+    for (int i=2; i<numKeys; i++)
+    {
+        PersistentNode* version = tree.insert(keys[i]);
+
+        // Insertion order puts the first i+1 keys into version i
+        if (PersistentTree::getNumVertices(version) != i+1) consistent = false;
+    }
+
+    done = true;
+
+    for (thread& t : readers) t.join();
+
+    PersistentNode* last = tree.snapshot();
+
+    vector<int> sorted = keys;
+
+    sort(sorted.begin(), sorted.end());
+
+    printf("Newest version matches the inserted keys %d\n", PersistentTree::inOrder(last) == sorted);
+
+    printf("Versions read consistently by %d readers over %lld reads %d\n", numReaders, reads.load(), consistent.load());
+
+    printf("Height %d for %d values\n", PersistentTree::getHeight(last), PersistentTree::getNumVertices(last));
+
+    // The next version shares all but O(log n) nodes with the snapshot
+    long long before = tree.getLiveNodes();
+
+    tree.insert(numKeys);
+
+    printf("New nodes for one insert %lld\n", tree.getLiveNodes() - before);
+
+    tree.release(last);
+
+    tree.reclaim();
+
+    printf("Live nodes after releasing old versions %lld for %d values\n", tree.getLiveNodes(), numKeys + 1);
+}
@@ -0,0 +1,425 @@
+#include "persistent-tree.h"
+
+using namespace std;
+
+/**
+ * This is an implementation of a persistent AVL tree by path copying
+ * An insert copies the O(log n) nodes on the path to val, rotations only
+ * Ever touch copies, so every older version stays intact and readable
+ *
+ * Nodes count the parents and versions referencing them. Releasing a version
+ * Retires the nodes only it reached, tagged with the current epoch. Readers
+ * Announce the epoch they started in, and a node retired in epoch r is freed
+ * Once every pinned reader announced an epoch after r, as such readers
+ * Started after the node became unreachable
+ */
+
+/**
+ * Creates an empty persistent tree
+ */
+PersistentTree::PersistentTree()
+{
+    this->latest.store(nullptr);
+
+    this->liveNodes.store(0);
+}
+
+/**
+ * Returns the height of the tree rooted at node
+ *
+ * @param PersistentNode* node
+ * @return int
+ */
+int PersistentTree::heightOf(PersistentNode* node)
+{
+    return node ? node->height : 0;
+}
+
+/**
+ * Returns the number of nodes in the tree rooted at node
+ *
+ * @param PersistentNode* node
+ * @return int
+ */
+int PersistentTree::sizeOf(PersistentNode* node)
+{
+    return node ? node->size : 0;
+}
+
+/**
+ * Creates a new node over the given children, which gain a reference
+ *
+ * @param int val
+ * @param PersistentNode* left
+ * @param PersistentNode* right
+ * @return PersistentNode*
+ */
+PersistentNode* PersistentTree::makeNode(int val, PersistentNode* left, PersistentNode* right)
+{
+    PersistentNode* node = new PersistentNode();
+
+    node->value = val;
+
+    node->left = left;
+
+    node->right = right;
+
+    node->refs = 0;
+
+    node->height = max(heightOf(left), heightOf(right)) + 1;
+
+    node->size = sizeOf(left) + sizeOf(right) + 1;
+
+    if (left) left->refs++;
+
+    if (right) right->refs++;
+
+    this->liveNodes.fetch_add(1, memory_order_relaxed);
+
+    return node;
+}
+
+/**
+ * Deletes node if nothing references it, as it was never published
+ * Rotations consume the fresh copies they take apart
+ *
+ * @param PersistentNode* node
+ * @return void
+ */
+void PersistentTree::discardIfUnreferenced(PersistentNode* node)
+{
+    if (!node || node->refs > 0) return;
+
+    PersistentNode* left = node->left;
+
+    PersistentNode* right = node->right;
+
+    delete node;
+
+    this->liveNodes.fetch_sub(1, memory_order_relaxed);
+
+    if (left && --left->refs == 0) this->discardIfUnreferenced(left);
+
+    if (right && --right->refs == 0) this->discardIfUnreferenced(right);
+}
+
+/**
+ * Returns a new balanced node holding val over left and right
+ * left and right differ in height by at most 2
+ *
+ * @param int val
+ * @param PersistentNode* left
+ * @param PersistentNode* right
+ * @return PersistentNode*
+ */
+PersistentNode* PersistentTree::balance(int val, PersistentNode* left, PersistentNode* right)
+{
+    PersistentNode* res;
+
+    if (heightOf(left) > heightOf(right) + 1)
+    {
+        if (heightOf(left->left) >= heightOf(left->right))
+        {
+            res = this->makeNode(left->value, left->left, this->makeNode(val, left->right, right));
+        }
+        else
+        {
+            PersistentNode* mid = left->right;
+
+            res = this->makeNode(mid->value,
+                this->makeNode(left->value, left->left, mid->left),
+                this->makeNode(val, mid->right, right));
+        }
+
+        this->discardIfUnreferenced(left);
+    }
+    else if (heightOf(right) > heightOf(left) + 1)
+    {
+        if (heightOf(right->right) >= heightOf(right->left))
+        {
+            res = this->makeNode(right->value, this->makeNode(val, left, right->left), right->right);
+        }
+        else
+        {
+            PersistentNode* mid = right->left;
+
+            res = this->makeNode(mid->value,
+                this->makeNode(val, left, mid->left),
+                this->makeNode(right->value, mid->right, right->right));
+        }
+
+        this->discardIfUnreferenced(right);
+    }
+    else
+    {
+        res = this->makeNode(val, left, right);
+    }
+
+    return res;
+}
+
+/**
+ * Returns the root of a copy of the tree rooted at node with val inserted
+ * Recursion depth is bounded by the AVL height
+ *
+ * @param PersistentNode* node
+ * @param int val
+ * @return PersistentNode*
+ */
+PersistentNode* PersistentTree::recursiveInsert(PersistentNode* node, int val)
+{
+    if (!node) return this->makeNode(val, nullptr, nullptr);
+
+    if (node->value >= val)
+    {
+        return this->balance(node->value, this->recursiveInsert(node->left, val), node->right);
+    }
+
+    return this->balance(node->value, node->left, this->recursiveInsert(node->right, val));
+}
+
+/**
+ * Drops one reference to node, retiring every node that becomes unreachable
+ * Must be called while holding writerMutex
+ *
+ * @param PersistentNode* node
+ * @return void
+ */
+void PersistentTree::unreference(PersistentNode* node)
+{
+    if (!node || --node->refs > 0) return;
+
+    uint64_t epoch = this->epochs.getEpoch();
+
+    vector<PersistentNode*> stack;
+
+    stack.push_back(node);
+
+    while (!stack.empty())
+    {
+        PersistentNode* curr = stack.back();
+
+        stack.pop_back();
+
+        // Readers may still be walking curr, so it is only retired here
+        this->retired.push_back(make_pair(curr, epoch));
+
+        if (curr->left && --curr->left->refs == 0) stack.push_back(curr->left);
+
+        if (curr->right && --curr->right->refs == 0) stack.push_back(curr->right);
+    }
+
+    if (this->retired.size() >= RECLAIM_THRESHOLD) this->reclaimRetired();
+}
+
+/**
+ * Frees the retired nodes that no pinned reader can still reach
+ * Must be called while holding writerMutex
+ *
+ * @return void
+ */
+void PersistentTree::reclaimRetired()
+{
+    uint64_t oldest = this->epochs.oldestPinned();
+
+    int kept = 0;
+
+    for (size_t i=0; i<this->retired.size(); i++)
+    {
+        if (this->retired[i].second < oldest)
+        {
+            delete this->retired[i].first;
+
+            this->liveNodes.fetch_sub(1, memory_order_relaxed);
+        }
+        else
+        {
+            this->retired[kept++] = this->retired[i];
+        }
+    }
+
+    this->retired.resize(kept);
+}
+
+/**
+ * Inserts val into a copy of the newest version, in O(log n) new nodes
+ * Returns the new version, which stays readable while the caller is pinned
+ *
+ * @param int val
+ * @return PersistentNode*
+ */
+PersistentNode* PersistentTree::insert(int val)
+{
+    lock_guard<mutex> lock(this->writerMutex);
+
+    PersistentNode* prev = this->latest.load(memory_order_relaxed);
+
+    PersistentNode* next = this->recursiveInsert(prev, val);
+
+    next->refs++;
+
+    // Every node of the new version is complete before it is published
+    this->latest.store(next, memory_order_release);
+
+    this->unreference(prev);
+
+    return next;
+}
+
+/**
+ * Returns the newest version, readable while the caller is pinned
+ *
+ * @return PersistentNode*
+ */
+PersistentNode* PersistentTree::getLatest()
+{
+    return this->latest.load(memory_order_acquire);
+}
+
+/**
+ * Returns the newest version, which stays readable until it is released
+ *
+ * @return PersistentNode*
+ */
+PersistentNode* PersistentTree::snapshot()
+{
+    lock_guard<mutex> lock(this->writerMutex);
+
+    PersistentNode* version = this->latest.load(memory_order_relaxed);
+
+    if (version) version->refs++;
+
+    return version;
+}
+
+/**
+ * Releases a version taken by snapshot
+ *
+ * @param PersistentNode* version
+ * @return void
+ */
+void PersistentTree::release(PersistentNode* version)
+{
+    lock_guard<mutex> lock(this->writerMutex);
+
+    this->unreference(version);
+}
+
+/**
+ * Frees the retired nodes that no pinned reader can still reach
+ * Runs on its own every RECLAIM_THRESHOLD retired nodes
+ *
+ * @return void
+ */
+void PersistentTree::reclaim()
+{
+    lock_guard<mutex> lock(this->writerMutex);
+
+    this->reclaimRetired();
+}
+
+/**
+ * Returns the epochs readers pin with an EpochGuard before they read a version
+ *
+ * @return EpochReclaimer&
+ */
+EpochReclaimer& PersistentTree::getEpochs()
+{
+    return this->epochs;
+}
+
+/**
+ * Checks whether a value exists in the newest version
+ *
+ * @param int val
+ * @return bool
+ */
+bool PersistentTree::exists(int val)
+{
+    EpochGuard guard(this->epochs);
+
+    return exists(this->getLatest(), val);
+}
+
+/**
+ * Returns the number of nodes allocated and not yet freed
+ *
+ * @return long long
+ */
+long long PersistentTree::getLiveNodes()
+{
+    return this->liveNodes.load(memory_order_relaxed);
+}
+
+/**
+ * Checks whether a value exists in version
+ *
+ * @param PersistentNode* version
+ * @param int val
+ * @return bool
+ */
+bool PersistentTree::exists(PersistentNode* version, int val)
+{
+    PersistentNode* curr = version;
+
+    while (curr && curr->value != val) curr = curr->value > val ? curr->left : curr->right;
+
+    return curr != nullptr;
+}
+
+/**
+ * Returns the number of values in version
+ *
+ * @param PersistentNode* version
+ * @return int
+ */
+int PersistentTree::getNumVertices(PersistentNode* version)
+{
+    return sizeOf(version);
+}
+
+/**
+ * Returns the height of version
+ *
+ * @param PersistentNode* version
+ * @return int
+ */
+int PersistentTree::getHeight(PersistentNode* version)
+{
+    return heightOf(version);
+}
+
+/**
+ * Returns version inOrder
+ *
+ * @param PersistentNode* version
+ * @return vector<int>
+ */
+vector<int> PersistentTree::inOrder(PersistentNode* version)
+{
+    vector<int> res;
+
+    vector<PersistentNode*> stack;
+
+    PersistentNode* curr = version;
+
+    while (curr || !stack.empty())
+    {
+        while (curr)
+        {
+            stack.push_back(curr);
+
+            curr = curr->left;
+        }
+
+        curr = stack.back();
+
+        stack.pop_back();
+
+        res.push_back(curr->value);
+
+        curr = curr->right;
+    }
+
+    return res;
+}
@@ -0,0 +1,276 @@
+#ifndef PERSISTENT_TREE
+#define PERSISTENT_TREE
+
+#include "epoch-reclaimer.cpp"
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+using namespace std;
+
+class PersistentNode
+{
+    public:
+        /**
+         * Value held at the node
+         *
+         * @param int value
+         */
+        int value;
+
+        /**
+         * Height of the tree rooted at this node
+         *
+         * @param int height
+         */
+        int height;
+
+        /**
+         * Number of nodes in the tree rooted at this node
+         *
+         * @param int size
+         */
+        int size;
+
+        /**
+         * Number of parents and versions referencing this node
+         * Only the writer, holding the tree's mutex, reads or changes it
+         *
+         * @param int refs
+         */
+        int refs;
+
+        /**
+         * Left child of the node, shared with other versions
+         *
+         * @param PersistentNode* left
+         */
+        PersistentNode* left;
+
+        /**
+         * Right child of the node, shared with other versions
+         *
+         * @param PersistentNode* right
+         */
+        PersistentNode* right;
+};
+
+/**
+ * Persistent AVL tree, every insert creates a new version by path copying
+ * A version is its root, and shares all untouched subtrees with older versions
+ * Readers of any version never lock, writers are serialized by a mutex
+ * Nodes are freed through epoch based reclamation once no version reaches them
+ */
+class PersistentTree
+{
+    private:
+        /**
+         * Newest version, the tree holds one reference to it
+         *
+         * @param atomic<PersistentNode*> latest
+         */
+        atomic<PersistentNode*> latest;
+
+        /**
+         * Serializes writers and guards the reference counts and retired list
+         *
+         * @param mutex writerMutex
+         */
+        mutex writerMutex;
+
+        /**
+         * Epochs of the pinned readers
+         *
+         * @param EpochReclaimer epochs
+         */
+        EpochReclaimer epochs;
+
+        /**
+         * Unreachable nodes waiting for readers to move on, with their retire epoch
+         *
+         * @param vector<pair<PersistentNode*, uint64_t>> retired
+         */
+        vector<pair<PersistentNode*, uint64_t>> retired;
+
+        /**
+         * Number of nodes allocated and not yet freed
+         *
+         * @param atomic<long long> liveNodes
+         */
+        atomic<long long> liveNodes;
+
+        /**
+         * Returns the height of the tree rooted at node
+         *
+         * @param PersistentNode* node
+         * @return int
+         */
+        static int heightOf(PersistentNode* node);
+
+        /**
+         * Returns the number of nodes in the tree rooted at node
+         *
+         * @param PersistentNode* node
+         * @return int
+         */
+        static int sizeOf(PersistentNode* node);
+
+        /**
+         * Creates a new node over the given children, which gain a reference
+         *
+         * @param int val
+         * @param PersistentNode* left
+         * @param PersistentNode* right
+         * @return PersistentNode*
+         */
+        PersistentNode* makeNode(int val, PersistentNode* left, PersistentNode* right);
+
+        /**
+         * Deletes node if nothing references it, as it was never published
+         *
+         * @param PersistentNode* node
+         * @return void
+         */
+        void discardIfUnreferenced(PersistentNode* node);
+
+        /**
+         * Returns a new balanced node holding val over left and right
+         * left and right differ in height by at most 2
+         *
+         * @param int val
+         * @param PersistentNode* left
+         * @param PersistentNode* right
+         * @return PersistentNode*
+         */
+        PersistentNode* balance(int val, PersistentNode* left, PersistentNode* right);
+
+        /**
+         * Returns the root of a copy of the tree rooted at node with val inserted
+         *
+         * @param PersistentNode* node
+         * @param int val
+         * @return PersistentNode*
+         */
+        PersistentNode* recursiveInsert(PersistentNode* node, int val);
+
+        /**
+         * Drops one reference to node, retiring every node that becomes unreachable
+         * Must be called while holding writerMutex
+         *
+         * @param PersistentNode* node
+         * @return void
+         */
+        void unreference(PersistentNode* node);
+
+        /**
+         * Frees the retired nodes that no pinned reader can still reach
+         * Must be called while holding writerMutex
+         *
+         * @return void
+         */
+        void reclaimRetired();
+
+    public:
+        /**
+         * Creates an empty persistent tree
+         */
+        PersistentTree();
+
+        /**
+         * Inserts val into a copy of the newest version, in O(log n) new nodes
+         * Returns the new version, which stays readable while the caller is pinned
+         *
+         * @param int val
+         * @return PersistentNode*
+         */
+        PersistentNode* insert(int val);
+
+        /**
+         * Returns the newest version, readable while the caller is pinned
+         *
+         * @return PersistentNode*
+         */
+        PersistentNode* getLatest();
+
+        /**
+         * Returns the newest version, which stays readable until it is released
+         *
+         * @return PersistentNode*
+         */
+        PersistentNode* snapshot();
+
+        /**
+         * Releases a version taken by snapshot
+         *
+         * @param PersistentNode* version
+         * @return void
+         */
+        void release(PersistentNode* version);
+
+        /**
+         * Frees the retired nodes that no pinned reader can still reach
+         * Runs on its own every RECLAIM_THRESHOLD retired nodes
+         *
+         * @return void
+         */
+        void reclaim();
+
+        /**
+         * Returns the epochs readers pin with an EpochGuard before they read a version
+         *
+         * @return EpochReclaimer&
+         */
+        EpochReclaimer& getEpochs();
+
+        /**
+         * Checks whether a value exists in the newest version
+         *
+         * @param int val
+         * @return bool
+         */
+        bool exists(int val);
+
+        /**
+         * Returns the number of nodes allocated and not yet freed
+         *
+         * @return long long
+         */
+        long long getLiveNodes();
+
+        /**
+         * Checks whether a value exists in version
+         *
+         * @param PersistentNode* version
+         * @param int val
+         * @return bool
+         */
+        static bool exists(PersistentNode* version, int val);
+
+        /**
+         * Returns the number of values in version
+         *
+         * @param PersistentNode* version
+         * @return int
+         */
+        static int getNumVertices(PersistentNode* version);
+
+        /**
+         * Returns the height of version
+         *
+         * @param PersistentNode* version
+         * @return int
+         */
+        static int getHeight(PersistentNode* version);
+
+        /**
+         * Returns version inOrder
+         *
+         * @param PersistentNode* version
+         * @return vector<int>
+         */
+        static vector<int> inOrder(PersistentNode* version);
+};
+
+#endif
@@ -0,0 +1,158 @@
+#include "prefix-sum-table.h"
+
+using namespace std;
+
+/**
+ * Creates an empty table
+ */
+PrefixSumTable::PrefixSumTable()
+{
+    this->mask = 15;
+
+    this->used = 0;
+
+    this->keys.assign(this->mask + 1, 0);
+
+    this->counts.assign(this->mask + 1, 0);
+}
+
+/**
+ * Returns the home slot of key
+ *
+ * @param long long key
+ * @return int
+ */
+int PrefixSumTable::slotOf(long long key)
+{
+    unsigned long long h = (unsigned long long) key * 0x9e3779b97f4a7c15ULL;
+
+    return (int) (h >> 32) & this->mask;
+}
+
+/**
+ * Doubles the number of slots
+ *
+ * @return void
+ */
+void PrefixSumTable::grow()
+{
+    vector<long long> oldKeys = this->keys;
+
+    vector<int> oldCounts = this->counts;
+
+    this->mask = 2 * this->mask + 1;
+
+    this->keys.assign(this->mask + 1, 0);
+
+    this->counts.assign(this->mask + 1, 0);
+
+    for (size_t i=0; i<oldKeys.size(); i++)
+    {
+        if (!oldCounts[i]) continue;
+
+        int slot = this->slotOf(oldKeys[i]);
+
+        while (this->counts[slot]) slot = (slot + 1) & this->mask;
+
+        this->keys[slot] = oldKeys[i];
+
+        this->counts[slot] = oldCounts[i];
+    }
+}
+
+/**
+ * Returns how many times key was added and not removed
+ *
+ * @param long long key
+ * @return int
+ */
+int PrefixSumTable::count(long long key)
+{
+    int slot = this->slotOf(key);
+
+    while (this->counts[slot])
+    {
+        if (this->keys[slot] == key) return this->counts[slot];
+
+        slot = (slot + 1) & this->mask;
+    }
+
+    return 0;
+}
+
+/**
+ * Adds one occurrence of key
+ *
+ * @param long long key
+ * @return void
+ */
+void PrefixSumTable::add(long long key)
+{
+    int slot = this->slotOf(key);
+
+    while (this->counts[slot])
+    {
+        if (this->keys[slot] == key)
+        {
+            this->counts[slot]++;
+
+            return;
+        }
+
+        slot = (slot + 1) & this->mask;
+    }
+
+    this->keys[slot] = key;
+
+    this->counts[slot] = 1;
+
+    // Kept at most half full, so probe runs stay short
+    if (2 * ++this->used > this->mask) this->grow();
+}
+
+/**
+ * Removes one occurrence of key, which must be in the table
+ *
+ * @param long long key
+ * @return void
+ */
+void PrefixSumTable::remove(long long key)
+{
+    int slot = this->slotOf(key);
+
+    while (this->keys[slot] != key || !this->counts[slot]) slot = (slot + 1) & this->mask;
+
+    if (--this->counts[slot]) return;
+
+    this->used--;
+
+    // Shift later entries of the probe run back, unless that would move them before their home
+    int hole = slot;
+
+    for (int next = (hole + 1) & this->mask; this->counts[next]; next = (next + 1) & this->mask)
+    {
+        int home = this->slotOf(this->keys[next]);
+
+        if (((next - home) & this->mask) < ((next - hole) & this->mask)) continue;
+
+        this->keys[hole] = this->keys[next];
+
+        this->counts[hole] = this->counts[next];
+
+        this->counts[next] = 0;
+
+        hole = next;
+    }
+}
+
+/**
+ * Removes every key
+ *
+ * @return void
+ */
+void PrefixSumTable::clear()
+{
+    this->counts.assign(this->mask + 1, 0);
+
+    this->used = 0;
+}
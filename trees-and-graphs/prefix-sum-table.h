@@ -0,0 +1,98 @@
+#ifndef PREFIX_SUM_TABLE
+#define PREFIX_SUM_TABLE
+
+#include <vector>
+
+using namespace std;
+
+/**
+ * Multiset of prefix sums, as an open addressing table with linear probing
+ * Keys and counts live in two flat arrays, and a key whose count drops to 0 is
+ * Deleted by shifting back the probe run, so the table only ever holds the
+ * Keys currently counted, and needs no tombstones
+ */
+class PrefixSumTable
+{
+    private:
+        /**
+         * Key of every slot
+         *
+         * @param vector<long long> keys
+         */
+        vector<long long> keys;
+
+        /**
+         * Count of every slot, 0 for an empty slot
+         *
+         * @param vector<int> counts
+         */
+        vector<int> counts;
+
+        /**
+         * Number of slots minus 1, the number of slots is a power of 2
+         *
+         * @param int mask
+         */
+        int mask;
+
+        /**
+         * Number of slots in use
+         *
+         * @param int used
+         */
+        int used;
+
+        /**
+         * Returns the home slot of key
+         *
+         * @param long long key
+         * @return int
+         */
+        int slotOf(long long key);
+
+        /**
+         * Doubles the number of slots
+         *
+         * @return void
+         */
+        void grow();
+
+    public:
+        /**
+         * Creates an empty table
+         */
+        PrefixSumTable();
+
+        /**
+         * Returns how many times key was added and not removed
+         *
+         * @param long long key
+         * @return int
+         */
+        int count(long long key);
+
+        /**
+         * Adds one occurrence of key
+         *
+         * @param long long key
+         * @return void
+         */
+        void add(long long key);
+
+        /**
+         * Removes one occurrence of key, which must be in the table
+         *
+         * @param long long key
+         * @return void
+         */
+        void remove(long long key);
+
+        /**
+         * Removes every key
+         *
+         * @return void
+         */
+        void clear();
+};
+
+#endif
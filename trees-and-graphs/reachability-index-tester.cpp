@@ -0,0 +1,138 @@
+#include "directed-graph.cpp"
+#include "bidirectional-bfs.cpp"
+#include "reachability-index.cpp"
+#include <vector>
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <atomic>
+
+using namespace std;
+
+/**
+ * Builds a reachability index over a random dependency like graph, and reports
+ * The build time, the memory used, the query time and how queries were answered
+ * Most edges go from a lower to a higher vertex, a few go back and close cycles
+ * Answers are checked against a bidirectional search on a sample of the queries
+ * Then the same queries run on numThreads threads at once
+ *
+ * Usage: ./reachability-index-tester [numVertices] [averageDegree] [numQueries] [numLabels] [numThreads]
+ *
+ * @see reachability-index.cpp
+ */
+
+/**
+ * Returns the milliseconds elapsed since start
+ *
+ * @param chrono::steady_clock::time_point start
+ * @return double
+ */
+double elapsedMs(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    int numVertices = argc > 1 ? stoi(argv[1]) : 1000000;
+
+    int averageDegree = argc > 2 ? stoi(argv[2]) : 4;
+
+    int numQueries = argc > 3 ? stoi(argv[3]) : 100000;
+
+    int numLabels = argc > 4 ? stoi(argv[4]) : 3;
+
+    int numThreads = argc > 5 ? stoi(argv[5]) : max(2u, thread::hardware_concurrency());
+
+    mt19937 rng(42);
+
+    DirectedGraph dg = DirectedGraph(numVertices);
+
+    for (long long i=0; i<(long long) numVertices * averageDegree; i++)
+    {
+        int u = rng() % numVertices;
+
+        // Mostly short forward edges, like dependencies between nearby modules
+        int v = u + 1 + rng() % 1000;
+
+        if (rng() % 1000 == 0) v = u - 1 - rng() % 100;
+
+        if (v >= 0 && v < numVertices) dg.addEdge(u, v);
+    }
+
+    dg.finalize();
+
+    auto start = chrono::steady_clock::now();
+
+    ReachabilityIndex index = ReachabilityIndex(dg, numLabels);
+
+    double buildMs = elapsedMs(start);
+
+    size_t graphBytes = (2 * (size_t) (numVertices + 1) + dg.getNumEdges()) * sizeof(int);
+
+    printf("V=%d E=%d components=%d dag edges=%d labels=%d\n", numVertices, dg.getNumEdges(),
+        index.getNumComponents(), index.getNumDagEdges(), numLabels);
+
+    printf("build=%.2fms index=%.2fMB graph=%.2fMB\n", buildMs, index.getMemoryUsage() / 1e6, graphBytes / 1e6);
+
+    vector<pair<int, int>> queries(numQueries);
+
+    for (pair<int, int>& query : queries) query = {(int) (rng() % numVertices), (int) (rng() % numVertices)};
+
+    int found = 0;
+
+    start = chrono::steady_clock::now();
+
+    for (pair<int, int>& query : queries) found += index.reachable(query.first, query.second);
+
+    double queryMs = elapsedMs(start);
+
+    printf("queries=%d found=%d query=%.1fns/op\n", numQueries, found, queryMs * 1e6 / max(numQueries, 1));
+
+    string rules[5] = {"same component", "ruled out by labels", "tree descendant", "landmark", "fallback search"};
+
+    for (int rule=0; rule<5; rule++)
+    {
+        printf("  %-20s %10lld (%.2f%%)\n", rules[rule].c_str(), index.getNumAnsweredBy(rule),
+            100.0 * index.getNumAnsweredBy(rule) / max(numQueries, 1));
+    }
+
+    long long fallbacks = index.getNumAnsweredBy(4);
+
+    printf("  components visited per fallback %.1f\n", fallbacks ? (double) index.getFallbackVisited() / fallbacks : 0.0);
+
+    BidirectionalBfs search = BidirectionalBfs(dg);
+
+    int sample = min(numQueries, 1000), mismatches = 0;
+
+    start = chrono::steady_clock::now();
+
+    for (int i=0; i<sample; i++) mismatches += search.pathExists(queries[i].first, queries[i].second) != index.reachable(queries[i].first, queries[i].second);
+
+    printf("checked %d queries against bidirectional search (%.1fus/op): %d mismatches\n", sample,
+        elapsedMs(start) * 1e3 / max(sample, 1), mismatches);
+
+    atomic<int> parallelFound(0);
+
+    vector<thread> pool;
+
+    start = chrono::steady_clock::now();
+
+    for (int t=0; t<numThreads; t++)
+    {
+        pool.push_back(thread([&, t]() {
+            int local = 0;
+
+            for (int i=t; i<numQueries; i+=numThreads) local += index.reachable(queries[i].first, queries[i].second);
+
+            parallelFound += local;
+        }));
+    }
+
+    for (thread& th : pool) th.join();
+
+    printf("queries on %d threads: %.1fns/op, found=%d\n", numThreads, elapsedMs(start) * 1e6 / max(numQueries, 1),
+        parallelFound.load());
+}
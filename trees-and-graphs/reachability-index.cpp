@@ -0,0 +1,442 @@
+#include "reachability-index.h"
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <random>
+#include <limits>
+#include <atomic>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * Builds an index of graph with numLabels interval labels per component
+ *
+ * @param DirectedGraph& graph
+ * @param int numLabels
+ */
+ReachabilityIndex::ReachabilityIndex(DirectedGraph& graph, int numLabels) : dag(0)
+{
+    this->graph = &graph;
+
+    this->numLabels = numLabels < 1 ? 1 : numLabels;
+
+    this->build();
+}
+
+/**
+ * Builds the index again, after the graph changed
+ *
+ * @return void
+ */
+void ReachabilityIndex::build()
+{
+    this->dag = this->graph->condensation(this->component);
+
+    int n = this->dag.getNumVertices();
+
+    // Edges go from higher to lower components, so decreasing order is topological
+    this->level.assign(n, 0);
+
+    for (int c=n-1; c>=0; c--)
+    {
+        for (int d : this->dag.neighbors(c)) this->level[d] = max(this->level[d], this->level[c] + 1);
+    }
+
+    this->intervals.assign((size_t) n * this->numLabels, {0, 0});
+
+    this->pre.assign(n, 0);
+
+    this->treeEnd.assign(n, 0);
+
+    for (atomic<long long>& count : this->answeredBy) count = 0;
+
+    this->fallbackVisited = 0;
+
+    // The first traversal starts from the sources, so its DFS trees cover the most
+    vector<int> roots(n);
+
+    for (int i=0; i<n; i++) roots[i] = n-1-i;
+
+    this->label(0, roots);
+
+    for (int t=1; t<this->numLabels; t++)
+    {
+        shuffle(roots.begin(), roots.end(), mt19937(t));
+
+        this->label(t, roots);
+    }
+
+    this->labelLandmarks();
+}
+
+/**
+ * Labels every component with traversal t, started from roots in order
+ * Odd traversals take the children in reverse, so the labels differ
+ * Explicit stack of (component, next child) frames, as the DAG may be deep
+ *
+ * @param int t
+ * @param vector<int>& roots
+ * @return void
+ */
+void ReachabilityIndex::label(int t, vector<int>& roots)
+{
+    int n = this->dag.getNumVertices();
+
+    vector<bool> seen(n, false);
+
+    vector<pair<int, int>> frames;
+
+    int preCounter = 0, postCounter = 0;
+
+    bool reversed = t % 2 == 1;
+
+    for (int r : roots)
+    {
+        if (seen[r]) continue;
+
+        seen[r] = true;
+
+        if (t == 0) this->pre[r] = preCounter++;
+
+        frames.push_back({r, 0});
+
+        while (!frames.empty())
+        {
+            int c = frames.back().first;
+
+            NeighborRange children = this->dag.neighbors(c);
+
+            if (frames.back().second < children.size())
+            {
+                int i = frames.back().second++;
+
+                int d = children[reversed ? children.size() - 1 - i : i];
+
+                if (seen[d]) continue;
+
+                seen[d] = true;
+
+                if (t == 0) this->pre[d] = preCounter++;
+
+                frames.push_back({d, 0});
+
+                continue;
+            }
+
+            frames.pop_back();
+
+            // Every child is finished by now, whether it was reached from c or before
+            int low = postCounter;
+
+            for (int d : children) low = min(low, this->intervals[(size_t) d * this->numLabels + t].first);
+
+            this->intervals[(size_t) c * this->numLabels + t] = {low, postCounter++};
+
+            if (t == 0) this->treeEnd[c] = preCounter - 1;
+        }
+    }
+}
+
+/**
+ * Picks the landmarks and fills the landmark masks of every component, in O(V + E)
+ * Landmarks are the components with the most (in + 1) * (out + 1) edges, as
+ * Many routes pass through them
+ *
+ * @return void
+ */
+void ReachabilityIndex::labelLandmarks()
+{
+    int n = this->dag.getNumVertices();
+
+    vector<int> inDegree(n, 0), candidates(n);
+
+    for (int c=0; c<n; c++)
+    {
+        for (int d : this->dag.neighbors(c)) inDegree[d]++;
+
+        candidates[c] = c;
+    }
+
+    int k = min(n, REACHABILITY_LANDMARKS);
+
+    auto degreeProduct = [&](int c) {
+        return (long long) (inDegree[c] + 1) * (this->dag.neighbors(c).size() + 1);
+    };
+
+    nth_element(candidates.begin(), candidates.begin() + k, candidates.end(), [&](int a, int b) {
+        return degreeProduct(a) > degreeProduct(b);
+    });
+
+    this->landmarksBelow.assign(n, 0);
+
+    this->landmarksAbove.assign(n, 0);
+
+    for (int i=0; i<k; i++)
+    {
+        this->landmarksBelow[candidates[i]] |= 1ULL << i;
+
+        this->landmarksAbove[candidates[i]] |= 1ULL << i;
+    }
+
+    // Edges go from higher to lower components, so increasing order sees every child first
+    for (int c=0; c<n; c++)
+    {
+        for (int d : this->dag.neighbors(c)) this->landmarksBelow[c] |= this->landmarksBelow[d];
+    }
+
+    // And decreasing order sees every parent first
+    for (int c=n-1; c>=0; c--)
+    {
+        for (int d : this->dag.neighbors(c)) this->landmarksAbove[d] |= this->landmarksAbove[c];
+    }
+}
+
+/**
+ * Returns whether a landmark is reached from component c and reaches component d
+ * Which proves a route from c to d
+ *
+ * @param int c
+ * @param int d
+ * @return bool
+ */
+bool ReachabilityIndex::throughLandmark(int c, int d)
+{
+    return (this->landmarksBelow[c] & this->landmarksAbove[d]) != 0;
+}
+
+/**
+ * Returns whether the labels rule out a route from component c to component d
+ * A route from c to d needs a higher level at d, and every interval of d inside the one of c
+ *
+ * @param int c
+ * @param int d
+ * @return bool
+ */
+bool ReachabilityIndex::ruledOut(int c, int d)
+{
+    if (this->level[c] >= this->level[d]) return true;
+
+    const pair<int, int>* from = &this->intervals[(size_t) c * this->numLabels];
+
+    const pair<int, int>* to = &this->intervals[(size_t) d * this->numLabels];
+
+    for (int t=0; t<this->numLabels; t++)
+    {
+        if (to[t].first < from[t].first || to[t].second > from[t].second) return true;
+    }
+
+    return false;
+}
+
+/**
+ * Returns whether d is in the DFS tree subtree of c, which implies a route
+ *
+ * @param int c
+ * @param int d
+ * @return bool
+ */
+bool ReachabilityIndex::treeDescendant(int c, int d)
+{
+    return this->pre[c] <= this->pre[d] && this->pre[d] <= this->treeEnd[c];
+}
+
+/**
+ * Returns whether component c reaches component d, by a pruned depth first search
+ * Components the labels rule out are never expanded, and the child closest to
+ * The level of d is expanded first, so the search heads towards d
+ * Marks are owned by the thread, so searches on different threads don't meet
+ *
+ * @param int c
+ * @param int d
+ * @return bool
+ */
+bool ReachabilityIndex::search(int c, int d)
+{
+    // Every search takes a new stamp, so marks left by earlier searches of any index never match
+    thread_local vector<int> visitStamp;
+
+    thread_local int stamp = 0;
+
+    size_t n = this->dag.getNumVertices();
+
+    if (visitStamp.size() < n) visitStamp.resize(n, 0);
+
+    if (stamp == numeric_limits<int>::max())
+    {
+        fill(visitStamp.begin(), visitStamp.end(), 0);
+
+        stamp = 0;
+    }
+
+    stamp++;
+
+    vector<int> stack = {c};
+
+    visitStamp[c] = stamp;
+
+    long long visited = 0;
+
+    bool found = false;
+
+    while (!found && !stack.empty())
+    {
+        int x = stack.back();
+
+        stack.pop_back();
+
+        size_t first = stack.size();
+
+        for (int y : this->dag.neighbors(x))
+        {
+            if (y == d)
+            {
+                found = true;
+
+                break;
+            }
+
+            if (visitStamp[y] == stamp) continue;
+
+            visitStamp[y] = stamp;
+
+            visited++;
+
+            if (this->ruledOut(y, d)) continue;
+
+            if (this->treeDescendant(y, d) || this->throughLandmark(y, d))
+            {
+                found = true;
+
+                break;
+            }
+
+            stack.push_back(y);
+        }
+
+        // The highest level child ends on top of the stack
+        sort(stack.begin() + first, stack.end(), [&](int a, int b) {
+            return this->level[a] < this->level[b];
+        });
+    }
+
+    this->fallbackVisited += visited;
+
+    return found;
+}
+
+/**
+ * Returns whether there is a route from u to v
+ *
+ * @param int u
+ * @param int v
+ * @return bool
+ */
+bool ReachabilityIndex::reachable(int u, int v)
+{
+    if (!this->graph->isVertexValid(u) || !this->graph->isVertexValid(v)) return false;
+
+    int c = this->component[u], d = this->component[v];
+
+    if (c == d)
+    {
+        this->answeredBy[0]++;
+
+        return true;
+    }
+
+    if (this->ruledOut(c, d))
+    {
+        this->answeredBy[1]++;
+
+        return false;
+    }
+
+    if (this->treeDescendant(c, d))
+    {
+        this->answeredBy[2]++;
+
+        return true;
+    }
+
+    if (this->throughLandmark(c, d))
+    {
+        this->answeredBy[3]++;
+
+        return true;
+    }
+
+    this->answeredBy[4]++;
+
+    return this->search(c, d);
+}
+
+/**
+ * Returns the number of strongly connected components
+ *
+ * @return int
+ */
+int ReachabilityIndex::getNumComponents()
+{
+    return this->dag.getNumVertices();
+}
+
+/**
+ * Returns the number of edges between components
+ *
+ * @return int
+ */
+int ReachabilityIndex::getNumDagEdges()
+{
+    return this->dag.getNumEdges();
+}
+
+/**
+ * Returns the number of bytes used by the index, besides the graph
+ * Counts the arrays, the DAG as its CSR form, but not the search marks every
+ * Querying thread keeps, one int per component
+ *
+ * @return size_t
+ */
+size_t ReachabilityIndex::getMemoryUsage()
+{
+    size_t n = this->dag.getNumVertices();
+
+    size_t bytes = this->component.size() * sizeof(int);
+
+    bytes += (2 * (n + 1) + this->dag.getNumEdges()) * sizeof(int);
+
+    bytes += this->level.size() * sizeof(int);
+
+    bytes += this->intervals.size() * sizeof(pair<int, int>);
+
+    bytes += (this->pre.size() + this->treeEnd.size()) * sizeof(int);
+
+    bytes += (this->landmarksBelow.size() + this->landmarksAbove.size()) * sizeof(uint64_t);
+
+    return bytes;
+}
+
+/**
+ * Returns the number of queries answered by rule since the index was built
+ * 0 same component, 1 ruled out by labels, 2 tree descendant, 3 landmark, 4 fallback search
+ *
+ * @param int rule
+ * @return long long
+ */
+long long ReachabilityIndex::getNumAnsweredBy(int rule)
+{
+    if (rule < 0 || rule > 4) return 0;
+
+    return this->answeredBy[rule];
+}
+
+/**
+ * Returns the number of components visited by fallback searches since the index was built
+ *
+ * @return long long
+ */
+long long ReachabilityIndex::getFallbackVisited()
+{
+    return this->fallbackVisited;
+}
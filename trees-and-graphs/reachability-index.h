@@ -0,0 +1,241 @@
+#ifndef REACHABILITY_INDEX
+#define REACHABILITY_INDEX
+
+#include "directed-graph.h"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+
+using namespace std;
+
+/**
+ * Number of landmark components, one bit each in a 64 bit word
+ */
+const int REACHABILITY_LANDMARKS = 64;
+
+/**
+ * Reachability index over a DirectedGraph, for many "is there a route from
+ * u to v" queries against a graph that changes rarely
+ * The graph is condensed into its DAG of strongly connected components, and
+ * Every component gets labels, in O(k (V + E)) time and O(V + k C) memory:
+ * - its topological level, the longest path to it from a source component
+ * - k interval labels [low, post] from k depth first traversals in different
+ *   Orders, where post is the post order number and low the smallest post
+ *   Order number it reaches, so if u reaches v then v's interval is inside u's
+ * - the pre order range of its subtree in the first traversal's DFS tree
+ * - the landmarks it reaches and the landmarks reaching it, as two bit masks
+ *   Over the REACHABILITY_LANDMARKS components of highest degree
+ * A query answers from the labels alone when u and v share a component, when a
+ * Level or an interval rules the route out, when v is a tree descendant of u,
+ * Or when a landmark is reached from u and reaches v
+ * Otherwise a depth first search over the DAG, pruned by the same labels,
+ * Decides it, so the few positive queries no label proves take a search
+ * Queries may run on many threads at once, each search uses marks owned by its
+ * Thread, but build must not run alongside queries
+ * Build again after the graph changes
+ */
+class ReachabilityIndex
+{
+    private:
+        /**
+         * Graph being indexed
+         *
+         * @param DirectedGraph* graph
+         */
+        DirectedGraph* graph;
+
+        /**
+         * Number of interval labels per component
+         *
+         * @param int numLabels
+         */
+        int numLabels;
+
+        /**
+         * Strongly connected component of every vertex
+         *
+         * @param vector<int> component
+         */
+        vector<int> component;
+
+        /**
+         * DAG of the strongly connected components
+         *
+         * @param DirectedGraph dag
+         */
+        DirectedGraph dag;
+
+        /**
+         * Topological level of every component
+         *
+         * @param vector<int> level
+         */
+        vector<int> level;
+
+        /**
+         * Interval labels, numLabels (low, post) pairs per component
+         *
+         * @param vector<pair<int, int>> intervals
+         */
+        vector<pair<int, int>> intervals;
+
+        /**
+         * Pre order number of every component in the first traversal
+         *
+         * @param vector<int> pre
+         */
+        vector<int> pre;
+
+        /**
+         * Last pre order number in the DFS tree subtree of every component
+         *
+         * @param vector<int> treeEnd
+         */
+        vector<int> treeEnd;
+
+        /**
+         * Landmarks reached from every component, one bit per landmark
+         *
+         * @param vector<uint64_t> landmarksBelow
+         */
+        vector<uint64_t> landmarksBelow;
+
+        /**
+         * Landmarks reaching every component, one bit per landmark
+         *
+         * @param vector<uint64_t> landmarksAbove
+         */
+        vector<uint64_t> landmarksAbove;
+
+        /**
+         * Number of queries answered since the index was built, by the rule that answered them
+         * Same component, ruled out by labels, tree descendant, landmark, fallback search
+         *
+         * @param atomic<long long> answeredBy[5]
+         */
+        atomic<long long> answeredBy[5];
+
+        /**
+         * Number of components visited by fallback searches
+         *
+         * @param atomic<long long> fallbackVisited
+         */
+        atomic<long long> fallbackVisited;
+
+        /**
+         * Labels every component with traversal t, started from roots in order
+         *
+         * @param int t
+         * @param vector<int>& roots
+         * @return void
+         */
+        void label(int t, vector<int>& roots);
+
+        /**
+         * Picks the landmarks and fills the landmark masks of every component
+         *
+         * @return void
+         */
+        void labelLandmarks();
+
+        /**
+         * Returns whether a landmark is reached from component c and reaches component d
+         *
+         * @param int c
+         * @param int d
+         * @return bool
+         */
+        bool throughLandmark(int c, int d);
+
+        /**
+         * Returns whether the labels rule out a route from component c to component d
+         *
+         * @param int c
+         * @param int d
+         * @return bool
+         */
+        bool ruledOut(int c, int d);
+
+        /**
+         * Returns whether d is in the DFS tree subtree of c, which implies a route
+         *
+         * @param int c
+         * @param int d
+         * @return bool
+         */
+        bool treeDescendant(int c, int d);
+
+        /**
+         * Returns whether component c reaches component d, by a pruned depth first search
+         *
+         * @param int c
+         * @param int d
+         * @return bool
+         */
+        bool search(int c, int d);
+
+    public:
+        /**
+         * Builds an index of graph with numLabels interval labels per component
+         *
+         * @param DirectedGraph& graph
+         * @param int numLabels
+         */
+        ReachabilityIndex(DirectedGraph& graph, int numLabels);
+
+        /**
+         * Builds the index again, after the graph changed
+         *
+         * @return void
+         */
+        void build();
+
+        /**
+         * Returns whether there is a route from u to v
+         *
+         * @param int u
+         * @param int v
+         * @return bool
+         */
+        bool reachable(int u, int v);
+
+        /**
+         * Returns the number of strongly connected components
+         *
+         * @return int
+         */
+        int getNumComponents();
+
+        /**
+         * Returns the number of edges between components
+         *
+         * @return int
+         */
+        int getNumDagEdges();
+
+        /**
+         * Returns the number of bytes used by the index, besides the graph
+         *
+         * @return size_t
+         */
+        size_t getMemoryUsage();
+
+        /**
+         * Returns the number of queries answered by rule since the index was built
+         * 0 same component, 1 ruled out by labels, 2 tree descendant, 3 landmark, 4 fallback search
+         *
+         * @param int rule
+         * @return long long
+         */
+        long long getNumAnsweredBy(int rule);
+
+        /**
+         * Returns the number of components visited by fallback searches since the index was built
+         *
+         * @return long long
+         */
+        long long getFallbackVisited();
+};
+
+#endif
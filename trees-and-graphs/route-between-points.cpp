@@ -1,4 +1,7 @@
 #include "directed-graph.cpp"
+#include "parallel-bfs.cpp"
+#include "bidirectional-bfs.cpp"
+#include <thread>
 #include <queue>
 #include <iostream>
 
@@ -6,6 +9,7 @@ using namespace std;
 
 /**
  * This method takes in a graph and returns whether a path exists from start to end
+ * Vertices are marked visited as they are queued, so each is queued at most once
  *
  * @param DirectedGraph& dg
  * @param int start
@@ -14,33 +18,38 @@ using namespace std;
  */
 bool doesPathExist(DirectedGraph& dg, int start, int end)
 {
+    if (!dg.isVertexValid(start) || !dg.isVertexValid(end)) return false;
+
+    if (start == end) return true;
+
     vector<bool> visited(dg.getNumVertices(), false);
 
     queue<int> bfs;
 
     bfs.push(start);
 
+    visited[start] = true;
+
     while (!bfs.empty())
     {
         int front = bfs.front();
 
-        // Break early when the end we find the end vertex
-        if (front == end) return true;
-
         bfs.pop();
 
-        visited[front] = true;
-
-        for (int v : dg.getAdjList(front))
+        for (int v : dg.neighbors(front))
         {
             if (visited[v]) continue;
 
+            // Break early as soon as the end vertex is discovered
+            if (v == end) return true;
+
+            visited[v] = true;
+
             bfs.push(v);
         }
     }
 
-    // Return whether we visited the end vertex
-    return visited[end];
+    return false;
 }
 
 int main()
@@ -71,6 +80,8 @@ int main()
 
     dg.addEdges(edges);
 
+    dg.finalize();
+
     cout << "Does a path exist between start and end? " << doesPathExist(dg, 0, 8) << endl;
 
     cout << "Does a path exist between start and end? " << doesPathExist(dg, 8, 0) << endl;
@@ -78,4 +89,32 @@ int main()
     cout << "Does a path exist between start and end? " << doesPathExist(dg, 3, 9) << endl;
 
     cout << "Does a path exist between start and end? " << doesPathExist(dg, 7, 5) << endl;
+
+    cout << endl;
+
+    ParallelBfs bfs = ParallelBfs(dg, thread::hardware_concurrency());
+
+    bfs.run(0);
+
+    for (int v=0; v<dg.getNumVertices(); v++)
+    {
+        printf("Vertex %d: distance %d, parent %d, path", v, bfs.getDistances()[v], bfs.getParents()[v]);
+
+        for (int w : bfs.getPath(v)) printf(" %d", w);
+
+        printf("\n");
+    }
+
+    cout << endl;
+
+    BidirectionalBfs search = BidirectionalBfs(dg);
+
+    for (pair<int, int> query : vector<pair<int, int>>{{0, 8}, {8, 0}, {3, 9}, {7, 5}})
+    {
+        printf("Bidirectional search from %d to %d: %d, path", query.first, query.second, search.pathExists(query.first, query.second));
+
+        for (int v : search.getPath()) printf(" %d", v);
+
+        printf(", %lld edges examined\n", search.getEdgesExamined());
+    }
 }
@@ -0,0 +1,184 @@
+#include "binary-search-tree.cpp"
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <string>
+#include <cmath>
+
+using namespace std;
+
+/**
+ * Benchmarks exists on the unbalanced, the AVL and the splay Binary Search Tree
+ * Lookups follow Zipfian traces, where the key of rank r is drawn with
+ * Probability proportional to 1 / r^s, so a few hot keys take most lookups
+ * The splay tree keeps hot keys near the root, the AVL tree keeps every key
+ * Within 1.44 log n, and the unbalanced tree is built from random keys
+ * Ranks are mapped to keys by a random permutation, so hot keys are scattered
+ *
+ * Usage: ./splay-benchmark [numKeys] [numLookups]
+ *
+ * @see binary-search-tree.cpp
+ */
+
+/**
+ * Returns the keys 1..n in a random order
+ *
+ * @param int n
+ * @param int seed
+ * @return vector<int>
+ */
+vector<int> randomSequence(int n, int seed)
+{
+    vector<int> v(n);
+
+    for (int i=0; i<n; i++) v[i] = i+1;
+
+    shuffle(v.begin(), v.end(), mt19937(seed));
+
+    return v;
+}
+
+/**
+ * Returns numLookups keys drawn from keys with a Zipfian distribution of exponent s
+ * keys[r] has rank r+1, s = 0 gives uniform lookups
+ *
+ * @param vector<int>& keys
+ * @param int numLookups
+ * @param double s
+ * @return vector<int>
+ */
+vector<int> zipfTrace(vector<int>& keys, int numLookups, double s)
+{
+    int n = keys.size();
+
+    vector<double> cdf(n);
+
+    double total = 0;
+
+    for (int r=0; r<n; r++)
+    {
+        total += 1.0 / pow(r + 1, s);
+
+        cdf[r] = total;
+    }
+
+    mt19937 rng(7);
+
+    uniform_real_distribution<double> uniform(0, total);
+
+    vector<int> trace(numLookups);
+
+    for (int i=0; i<numLookups; i++)
+    {
+        int rank = lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin();
+
+        trace[i] = keys[min(rank, n-1)];
+    }
+
+    return trace;
+}
+
+/**
+ * Returns the milliseconds elapsed since start
+ *
+ * @param chrono::steady_clock::time_point start
+ * @return double
+ */
+double elapsedMs(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Returns the name of mode
+ *
+ * @param BalanceMode mode
+ * @return string
+ */
+string modeName(BalanceMode mode)
+{
+    if (mode == BalanceMode::AVL) return "avl";
+
+    if (mode == BalanceMode::SPLAY) return "splay";
+
+    return "plain";
+}
+
+/**
+ * Inserts keys, then times exists over the trace and prints the latencies
+ * The mean comes from timing the whole trace, the percentiles from timing
+ * Batches of 64 lookups, so the clock doesn't dominate a single lookup
+ *
+ * @param BalanceMode mode
+ * @param double s
+ * @param vector<int>& keys
+ * @param vector<int>& trace
+ * @return void
+ */
+void runBenchmark(BalanceMode mode, double s, vector<int>& keys, vector<int>& trace)
+{
+    BinarySearchTree bst = BinarySearchTree(mode);
+
+    auto start = chrono::steady_clock::now();
+
+    for (int key : keys) bst.insert(key);
+
+    double insertMs = elapsedMs(start);
+
+    int found = 0;
+
+    start = chrono::steady_clock::now();
+
+    for (int key : trace) found += bst.exists(key);
+
+    double existsMs = elapsedMs(start);
+
+    const int batch = 64;
+
+    vector<double> batchNs;
+
+    for (int i=0; i+batch<=(int) trace.size(); i+=batch)
+    {
+        auto batchStart = chrono::steady_clock::now();
+
+        for (int j=i; j<i+batch; j++) found += bst.exists(trace[j]);
+
+        batchNs.push_back(chrono::duration<double, nano>(chrono::steady_clock::now() - batchStart).count() / batch);
+    }
+
+    sort(batchNs.begin(), batchNs.end());
+
+    double p50 = batchNs.empty() ? 0 : batchNs[batchNs.size() / 2];
+
+    double p99 = batchNs.empty() ? 0 : batchNs[batchNs.size() * 99 / 100];
+
+    printf("%-5s s=%.1f n=%-8zu lookups=%-8zu height=%-6d insert=%9.2fms exists=%8.1fns/op p50=%8.1fns p99=%8.1fns found=%d\n",
+        modeName(mode).c_str(), s, keys.size(), trace.size(), bst.getHeight(), insertMs,
+        existsMs * 1e6 / trace.size(), p50, p99, found);
+}
+
+int main(int argc, char** argv)
+{
+    int numKeys = argc > 1 ? stoi(argv[1]) : 1000000;
+
+    int numLookups = argc > 2 ? stoi(argv[2]) : 2000000;
+
+    // Random insertion order keeps the unbalanced tree O(log n) deep on average
+    vector<int> keys = randomSequence(numKeys, 42);
+
+    vector<int> ranks = randomSequence(numKeys, 43);
+
+    for (double s : {0.0, 0.8, 1.0, 1.2})
+    {
+        vector<int> trace = zipfTrace(ranks, numLookups, s);
+
+        for (BalanceMode mode : {BalanceMode::NONE, BalanceMode::AVL, BalanceMode::SPLAY})
+        {
+            runBenchmark(mode, s, keys, trace);
+        }
+
+        cout << endl;
+    }
+}
@@ -1,4 +1,5 @@
 #include "binary-search-tree.cpp"
+#include "threaded-binary-search-tree.cpp"
 #include <vector>
 #include <iostream>
 #include <list>
@@ -9,42 +10,9 @@ using namespace std;
  * Write an algorithm to find the nth rank in the BST
  *
  * @see binary-search-tree.cpp
+ * @see threaded-binary-search-tree.cpp
  */
 
-/**
- * Creates a tree of minimal height
- *
- * @param BinarySearchTree& bst
- * @param vectorint>& v
- * @param int start
- * @param int end
- * @return void
- */
-void minimalTree(BinarySearchTree& bst, vector<int>& v, int start, int end)
-{
-    if (start > end) return;
-
-    int mid = (start + end) / 2;
-
-    bst.insert(v[mid]);
-
-    minimalTree(bst, v, start, mid-1);
-
-    minimalTree(bst, v, mid+1, end);
-}
-
-/**
- * Creates a tree of minimal height
- *
- * @param BinarySearchTree& bst
- * @param vectorint>& v
- * @return void
- */
-void minimalTree(BinarySearchTree& bst, vector<int>& v)
-{
-    minimalTree(bst, v, 0, v.size()-1);
-}
-
 /**
  * Returns the left most child of curr
  *
@@ -105,7 +73,7 @@ int main()
 
     cout << endl;
 
-    minimalTree(bst, v);
+    bst.bulkLoad(v);
 
     printf("The height of the tree after insertion %d\n", bst.getHeight());
 
@@ -134,4 +102,28 @@ int main()
 
         cout << endl;
     }
+
+    // Threads take the place of climbing parent pointers
+    ThreadedBinarySearchTree threaded = ThreadedBinarySearchTree();
+
+    threaded.bulkLoad(v);
+
+    cout << "Threaded scan";
+
+    for (ThreadedTreeNode* node = threaded.first(); node; node = ThreadedBinarySearchTree::getSuccessor(node))
+    {
+        cout << " " << node->getValue();
+    }
+
+    cout << endl;
+
+    vector<int> range;
+
+    threaded.rangeScan(4, 9, range);
+
+    cout << "Threaded range scan [4, 9]";
+
+    for (int val : range) cout << " " << val;
+
+    cout << endl;
 }
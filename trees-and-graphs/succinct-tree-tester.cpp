@@ -0,0 +1,100 @@
+#include "binary-search-tree.cpp"
+#include "succinct-tree.cpp"
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <chrono>
+#include <string>
+
+using namespace std;
+
+/**
+ * Saves a Binary Search Tree in the succinct format, maps it back and checks
+ * The view and the tree rebuilt from it against the original
+ * Then compares the startup cost of re-inserting the in order dump,
+ * Mapping the saved tree, and rebuilding a mutable tree from it
+ *
+ * Usage: ./succinct-tree-tester [numKeys] [path]
+ *
+ * @see succinct-tree.cpp
+ * @see binary-search-tree.cpp
+ */
+
+/**
+ * Returns the milliseconds elapsed since start
+ *
+ * @param chrono::steady_clock::time_point start
+ * @return double
+ */
+double elapsedMs(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    int numKeys = argc > 1 ? stoi(argv[1]) : 1000000;
+
+    string path = argc > 2 ? argv[2] : "succinct-tree.bin";
+
+    BinarySearchTree bst = BinarySearchTree(BalanceMode::AVL);
+
+    mt19937 rng(42);
+
+    for (int i=0; i<numKeys; i++) bst.insert(rng() % numKeys);
+
+    ofstream out(path, ios::binary);
+
+    SuccinctTree::serialize(bst, out);
+
+    out.close();
+
+    vector<int> dump = bst.inOrder();
+
+    auto start = chrono::steady_clock::now();
+
+    BinarySearchTree reinserted = BinarySearchTree(BalanceMode::AVL);
+
+    for (int val : dump) reinserted.insert(val);
+
+    double reinsertMs = elapsedMs(start);
+
+    start = chrono::steady_clock::now();
+
+    SuccinctTree view(path);
+
+    double mapMs = elapsedMs(start);
+
+    start = chrono::steady_clock::now();
+
+    BinarySearchTree loaded = view.toBinarySearchTree(BalanceMode::AVL);
+
+    double rebuildMs = elapsedMs(start);
+
+    bool matches = view.inOrder() == dump && view.levelOrder() == bst.levelOrder();
+
+    matches = matches && view.getHeight() == bst.getHeight() && view.getNumVertices() == bst.getNumVertices();
+
+    for (int i=0; i<1000; i++)
+    {
+        int val = rng() % numKeys;
+
+        int n = 1 + rng() % bst.getNumVertices();
+
+        matches = matches && view.exists(val) == bst.exists(val) && view.rankOf(val) == bst.rankOf(val);
+
+        matches = matches && view.getNthRank(n) == bst.getNthRank(n)->getValue();
+    }
+
+    printf("Mapped view matches the saved tree %d\n", matches);
+
+    printf("Rebuilt tree has the same shape %d\n", loaded.levelOrder() == bst.levelOrder() && loaded.getBalanced());
+
+    printf("Saved %zu bytes for %d values, %.2f bytes per value\n",
+        view.getMemoryUsage(), view.getNumVertices(), (double) view.getMemoryUsage() / view.getNumVertices());
+
+    printf("Startup: re-insert %.2fms, map %.3fms, rebuild from shape %.2fms\n", reinsertMs, mapMs, rebuildMs);
+
+    remove(path.c_str());
+}
@@ -0,0 +1,335 @@
+#include "succinct-tree.h"
+#include <algorithm>
+#include <climits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+/**
+ * This is an implementation of a read only BST over a balanced parentheses file
+ * A node is written ( left ) right, so its ')' comes right after its left
+ * Subtree and the ')' are met in order, which is why the values are stored
+ * In order, one per ')'. Sorted values answer lookups and rank queries alone,
+ * The shape is only walked for levelOrder and to rebuild the exact tree
+ */
+
+/**
+ * Maps the file at path read only and views the tree saved in it
+ * Throws if the file can't be mapped or does not hold a succinct tree
+ *
+ * @param string path
+ */
+SuccinctTree::SuccinctTree(string path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+
+    if (fd < 0) throw "Can't open the succinct tree file";
+
+    struct stat info;
+
+    if (fstat(fd, &info) < 0 || info.st_size == 0)
+    {
+        close(fd);
+
+        throw "Not a succinct tree";
+    }
+
+    this->length = info.st_size;
+
+    this->mapping = mmap(nullptr, this->length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // The mapping stays valid once the descriptor is closed
+    close(fd);
+
+    if (this->mapping == MAP_FAILED)
+    {
+        this->mapping = nullptr;
+
+        throw "Can't map the succinct tree file";
+    }
+
+    try
+    {
+        this->attach(static_cast<const char*>(this->mapping), this->length);
+    }
+    catch (...)
+    {
+        munmap(this->mapping, this->length);
+
+        throw;
+    }
+}
+
+/**
+ * Views a saved tree held in memory, which must outlive the view
+ * data must be 8 byte aligned
+ * Throws if data does not hold a succinct tree
+ *
+ * @param const char* data
+ * @param size_t length
+ */
+SuccinctTree::SuccinctTree(const char* data, size_t length)
+{
+    this->mapping = nullptr;
+
+    this->length = length;
+
+    this->attach(data, length);
+}
+
+/**
+ * Unmaps the file, if mapped
+ */
+SuccinctTree::~SuccinctTree()
+{
+    if (this->mapping) munmap(this->mapping, this->length);
+}
+
+/**
+ * Returns the number of shape words for n values
+ *
+ * @param int n
+ * @return size_t
+ */
+size_t SuccinctTree::shapeWords(int n)
+{
+    return ((size_t) 2*n + 63) / 64;
+}
+
+/**
+ * Points the view at a saved tree of the given length
+ * Throws if data does not hold a succinct tree
+ *
+ * @param const char* data
+ * @param size_t length
+ * @return void
+ */
+void SuccinctTree::attach(const char* data, size_t length)
+{
+    if (length < SUCCINCT_HEADER_BYTES) throw "Not a succinct tree";
+
+    const uint32_t* header = reinterpret_cast<const uint32_t*>(data);
+
+    if (header[0] != SUCCINCT_MAGIC) throw "Not a succinct tree";
+
+    // A tree of n nodes has a height of 1 to n, and 0 only when it is empty
+    if (header[1] > INT_MAX || header[2] > header[1] || (header[1] > 0) != (header[2] > 0))
+    {
+        throw "Succinct tree is corrupt";
+    }
+
+    this->n = header[1];
+
+    this->height = header[2];
+
+    size_t words = shapeWords(this->n);
+
+    if (length < SUCCINCT_HEADER_BYTES + words * sizeof(uint64_t) + (size_t) this->n * sizeof(int))
+    {
+        throw "Succinct tree is truncated";
+    }
+
+    this->shape = reinterpret_cast<const uint64_t*>(data + SUCCINCT_HEADER_BYTES);
+
+    this->values = reinterpret_cast<const int*>(this->shape + words);
+}
+
+/**
+ * Writes bst to out in the succinct format, in O(n)
+ *
+ * @param BinarySearchTree& bst
+ * @param ostream& out
+ * @return void
+ */
+void SuccinctTree::serialize(BinarySearchTree& bst, ostream& out)
+{
+    int n = bst.getNumVertices();
+
+    vector<uint64_t> shape(shapeWords(n), 0);
+
+    vector<int> values;
+
+    values.reserve(n);
+
+    vector<TreeNode*> stack;
+
+    TreeNode* curr = bst.getRoot();
+
+    size_t bit = 0;
+
+    // '(' on the way down, ')' when the node is visited in order
+    while (curr || !stack.empty())
+    {
+        while (curr)
+        {
+            shape[bit >> 6] |= 1ULL << (bit & 63);
+
+            bit++;
+
+            stack.push_back(curr);
+
+            curr = curr->left;
+        }
+
+        curr = stack.back();
+
+        stack.pop_back();
+
+        bit++;
+
+        values.push_back(curr->value);
+
+        curr = curr->right;
+    }
+
+    uint32_t header[4] = { SUCCINCT_MAGIC, (uint32_t) n, (uint32_t) bst.getHeight(), 0 };
+
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    out.write(reinterpret_cast<const char*>(shape.data()), shape.size() * sizeof(uint64_t));
+
+    out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(int));
+}
+
+/**
+ * Checks whether a value exists in the tree
+ *
+ * @param int val
+ * @return bool
+ */
+bool SuccinctTree::exists(int val)
+{
+    const int* it = lower_bound(this->values, this->values + this->n, val);
+
+    return it != this->values + this->n && *it == val;
+}
+
+/**
+ * Returns the rank of the first occurrence of val by in order
+ * If val doesn't exist, returns the rank it would have once inserted
+ *
+ * @param int val
+ * @return int
+ */
+int SuccinctTree::rankOf(int val)
+{
+    return lower_bound(this->values, this->values + this->n, val) - this->values + 1;
+}
+
+/**
+ * Gets the nth value by in order
+ * n must be in the range [1, numVertices]
+ *
+ * @param int n
+ * @return int
+ */
+int SuccinctTree::getNthRank(int n)
+{
+    return this->values[n-1];
+}
+
+/**
+ * Returns the number of values in the tree
+ *
+ * @return int
+ */
+int SuccinctTree::getNumVertices()
+{
+    return this->n;
+}
+
+/**
+ * Returns the height of the tree
+ *
+ * @return int
+ */
+int SuccinctTree::getHeight()
+{
+    return this->height;
+}
+
+/**
+ * Returns the entire tree inOrder
+ *
+ * @return vector<int>
+ */
+vector<int> SuccinctTree::inOrder()
+{
+    return vector<int>(this->values, this->values + this->n);
+}
+
+/**
+ * Returns the entire tree levelOrder, read off the shape in O(n)
+ * Nodes of one level are met left to right, so in order works per level
+ * Throws if the shape is not balanced parentheses or is deeper than the saved height
+ *
+ * @return vector<vector<int>>
+ */
+vector<vector<int>> SuccinctTree::levelOrder()
+{
+    vector<vector<int>> res(this->height);
+
+    // Depths of the nodes whose ')' is still to come
+    vector<int> open;
+
+    int closedDepth = -1, k = 0;
+
+    for (size_t i=0; i<(size_t) 2*this->n; i++)
+    {
+        if ((this->shape[i >> 6] >> (i & 63)) & 1)
+        {
+            // A right child follows the ')' of its parent, a left child its '('
+            int depth = closedDepth >= 0 ? closedDepth + 1 : (open.empty() ? 0 : open.back() + 1);
+
+            if (depth >= this->height) throw "Succinct tree is corrupt";
+
+            open.push_back(depth);
+
+            closedDepth = -1;
+        }
+        else
+        {
+            if (open.empty()) throw "Succinct tree is corrupt";
+
+            closedDepth = open.back();
+
+            open.pop_back();
+
+            res[closedDepth].push_back(this->values[k++]);
+        }
+    }
+
+    // The deepest level must hold a node, or the saved height is too large
+    if (!open.empty() || (this->n > 0 && res.back().empty())) throw "Succinct tree is corrupt";
+
+    return res;
+}
+
+/**
+ * Returns the number of bytes of the saved tree
+ *
+ * @return size_t
+ */
+size_t SuccinctTree::getMemoryUsage()
+{
+    return SUCCINCT_HEADER_BYTES + shapeWords(this->n) * sizeof(uint64_t) + (size_t) this->n * sizeof(int);
+}
+
+/**
+ * Builds a mutable tree of the same shape and values in O(n)
+ * Throws if the shape is corrupt or breaks the AVL property of an AVL mode
+ *
+ * @param BalanceMode mode
+ * @return BinarySearchTree
+ */
+BinarySearchTree SuccinctTree::toBinarySearchTree(BalanceMode mode)
+{
+    BinarySearchTree bst = BinarySearchTree(mode);
+
+    bst.loadShape(this->shape, this->values, this->n);
+
+    return bst;
+}
@@ -0,0 +1,202 @@
+#ifndef SUCCINCT_TREE
+#define SUCCINCT_TREE
+
+#include "binary-search-tree.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <iostream>
+
+using namespace std;
+
+/**
+ * First word of a saved succinct tree
+ */
+const uint32_t SUCCINCT_MAGIC = 0x53425354;
+
+/**
+ * Bytes before the shape: magic, number of values, height and one unused word
+ */
+const size_t SUCCINCT_HEADER_BYTES = 16;
+
+/**
+ * Read only Binary Search Tree over its saved form
+ * The format is a header, the shape as 2n balanced parentheses bits packed in
+ * 64 bit words, where a node is written ( left ) right, and the n values in order
+ * The view answers queries straight from a memory mapped file, without any
+ * Nodes being built, and can turn into a mutable tree of the same shape in O(n)
+ */
+class SuccinctTree
+{
+    private:
+        /**
+         * Shape bits, 1 for '(' and 0 for ')'
+         *
+         * @param const uint64_t* shape
+         */
+        const uint64_t* shape;
+
+        /**
+         * Values in order
+         *
+         * @param const int* values
+         */
+        const int* values;
+
+        /**
+         * Number of values
+         *
+         * @param int n
+         */
+        int n;
+
+        /**
+         * Height of the saved tree
+         *
+         * @param int height
+         */
+        int height;
+
+        /**
+         * Start of the memory mapping, nullptr if the data isn't mapped by the view
+         *
+         * @param void* mapping
+         */
+        void* mapping;
+
+        /**
+         * Length of the memory mapping or of the viewed buffer
+         *
+         * @param size_t length
+         */
+        size_t length;
+
+        /**
+         * Points the view at a saved tree of the given length
+         * Throws if data does not hold a succinct tree
+         *
+         * @param const char* data
+         * @param size_t length
+         * @return void
+         */
+        void attach(const char* data, size_t length);
+
+        /**
+         * Returns the number of shape words for n values
+         *
+         * @param int n
+         * @return size_t
+         */
+        static size_t shapeWords(int n);
+
+    public:
+        /**
+         * Maps the file at path read only and views the tree saved in it
+         * Throws if the file can't be mapped or does not hold a succinct tree
+         *
+         * @param string path
+         */
+        SuccinctTree(string path);
+
+        /**
+         * Views a saved tree held in memory, which must outlive the view
+         * data must be 8 byte aligned
+         * Throws if data does not hold a succinct tree
+         *
+         * @param const char* data
+         * @param size_t length
+         */
+        SuccinctTree(const char* data, size_t length);
+
+        SuccinctTree(const SuccinctTree& other) = delete;
+
+        SuccinctTree& operator=(const SuccinctTree& other) = delete;
+
+        /**
+         * Unmaps the file, if mapped
+         */
+        ~SuccinctTree();
+
+        /**
+         * Writes bst to out in the succinct format, in O(n)
+         *
+         * @param BinarySearchTree& bst
+         * @param ostream& out
+         * @return void
+         */
+        static void serialize(BinarySearchTree& bst, ostream& out);
+
+        /**
+         * Checks whether a value exists in the tree
+         *
+         * @param int val
+         * @return bool
+         */
+        bool exists(int val);
+
+        /**
+         * Returns the rank of the first occurrence of val by in order
+         * If val doesn't exist, returns the rank it would have once inserted
+         *
+         * @param int val
+         * @return int
+         */
+        int rankOf(int val);
+
+        /**
+         * Gets the nth value by in order
+         * n must be in the range [1, numVertices]
+         *
+         * @param int n
+         * @return int
+         */
+        int getNthRank(int n);
+
+        /**
+         * Returns the number of values in the tree
+         *
+         * @return int
+         */
+        int getNumVertices();
+
+        /**
+         * Returns the height of the tree
+         *
+         * @return int
+         */
+        int getHeight();
+
+        /**
+         * Returns the entire tree inOrder
+         *
+         * @return vector<int>
+         */
+        vector<int> inOrder();
+
+        /**
+         * Returns the entire tree levelOrder, read off the shape in O(n)
+         * Throws if the shape is not balanced parentheses or is deeper than the saved height
+         *
+         * @return vector<vector<int>>
+         */
+        vector<vector<int>> levelOrder();
+
+        /**
+         * Returns the number of bytes of the saved tree
+         *
+         * @return size_t
+         */
+        size_t getMemoryUsage();
+
+        /**
+         * Builds a mutable tree of the same shape and values in O(n)
+         * Throws if the shape is corrupt or breaks the AVL property of an AVL mode
+         *
+         * @param BalanceMode mode
+         * @return BinarySearchTree
+         */
+        BinarySearchTree toBinarySearchTree(BalanceMode mode);
+};
+
+#endif
@@ -0,0 +1,148 @@
+#include "directed-graph.cpp"
+#include "task-scheduler.cpp"
+#include <vector>
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+/**
+ * Runs the projects of build-order.cpp on a task scheduler, and prints when
+ * Every project ran and on which thread
+ * Then runs a random build graph with a long chain of slow tasks serially in
+ * Build order, on the scheduler counting every task as the same time, and on
+ * The scheduler with the time of every task, which starts the slow chain first
+ * Tasks sleep for their time, so the schedules compare on any number of cores
+ *
+ * Usage: ./task-scheduler-benchmark [numTasks] [numThreads]
+ *
+ * @see task-scheduler.cpp
+ */
+
+/**
+ * Returns the milliseconds elapsed since start
+ *
+ * @param chrono::steady_clock::time_point start
+ * @return double
+ */
+double elapsedMs(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Prints the makespan of a run, against the best any schedule could do
+ * Which is the longer of the critical path and the work spread over every thread
+ *
+ * @param string name
+ * @param double makespan
+ * @param double criticalPath
+ * @param double work
+ * @param int numThreads
+ * @param long long steals
+ * @return void
+ */
+void printRun(string name, double makespan, double criticalPath, double work, int numThreads, long long steals)
+{
+    double bound = max(criticalPath, work / numThreads);
+
+    printf("%-22s makespan=%8.2fms bound=%8.2fms utilization=%5.1f%% steals=%lld\n", name.c_str(), makespan,
+        bound, 100.0 * work / (makespan * numThreads), steals);
+}
+
+int main(int argc, char** argv)
+{
+    int numTasks = argc > 1 ? stoi(argv[1]) : 400;
+
+    int numThreads = argc > 2 ? stoi(argv[2]) : thread::hardware_concurrency();
+
+    // The projects of build-order.cpp, d depends on a, b depends on f, and so on
+    DirectedGraph projects = DirectedGraph(6);
+
+    vector<vector<int>> edges = {
+        {3, 0},
+        {1, 5},
+        {3, 1},
+        {0, 5},
+        {2, 3},
+    };
+
+    projects.addEdges(edges);
+
+    vector<double> projectMs = {4, 2, 1, 3, 2, 5};
+
+    TaskScheduler scheduler = TaskScheduler(projects, 2);
+
+    scheduler.run([&](int u) { this_thread::sleep_for(chrono::microseconds((int) (projectMs[u] * 1000))); }, projectMs);
+
+    vector<double> startTimes = scheduler.getStartTimes(), finishTimes = scheduler.getFinishTimes();
+
+    vector<int> workers = scheduler.getWorkers();
+
+    for (int u=0; u<6; u++)
+    {
+        printf("project %c thread %d start %6.2fms finish %6.2fms\n", 'a' + u, workers[u], startTimes[u], finishTimes[u]);
+    }
+
+    printf("makespan %.2fms, critical path %.2fms\n\n", scheduler.getMakespan(), scheduler.getCriticalPath());
+
+    mt19937 rng(42);
+
+    DirectedGraph dg = DirectedGraph(numTasks);
+
+    vector<double> taskMs(numTasks);
+
+    double work = 0;
+
+    for (int u=0; u<numTasks; u++)
+    {
+        // Every 40th task is slow and depends on the one before it, the rest depend on recent tasks
+        if (u % 40 == 0)
+        {
+            taskMs[u] = 8;
+
+            if (u >= 40) dg.addEdge(u, u - 40);
+        }
+        else
+        {
+            taskMs[u] = 0.2 + (rng() % 800) / 1000.0;
+
+            for (int i=0; i<3 && u>0; i++) dg.addEdge(u, u - 1 - rng() % min(u, 30));
+        }
+
+        work += taskMs[u];
+    }
+
+    auto task = [&](int u) { this_thread::sleep_for(chrono::microseconds((int) (taskMs[u] * 1000))); };
+
+    // Every task comes before its dependencies, so the build order is the reverse
+    vector<int> order = dg.topologicalSort();
+
+    auto start = chrono::steady_clock::now();
+
+    for (int i=numTasks-1; i>=0; i--) task(order[i]);
+
+    double serialMs = elapsedMs(start);
+
+    TaskScheduler pool = TaskScheduler(dg, numThreads);
+
+    pool.run(task, taskMs);
+
+    double criticalPath = pool.getCriticalPath();
+
+    printf("tasks=%d edges=%d threads=%d work=%.2fms critical path=%.2fms\n\n", numTasks, dg.getNumEdges(),
+        numThreads, work, criticalPath);
+
+    printRun("serial build order", serialMs, criticalPath, work, 1, 0);
+
+    pool.run(task);
+
+    printRun("same time estimates", pool.getMakespan(), criticalPath, work, numThreads, pool.getNumSteals());
+
+    pool.run(task, taskMs);
+
+    printRun("critical path first", pool.getMakespan(), criticalPath, work, numThreads, pool.getNumSteals());
+}
@@ -0,0 +1,351 @@
+#include "task-scheduler.h"
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <chrono>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * Creates a scheduler over graph with numThreads threads
+ *
+ * @param DirectedGraph& graph
+ * @param int numThreads
+ */
+TaskScheduler::TaskScheduler(DirectedGraph& graph, int numThreads)
+{
+    this->graph = &graph;
+
+    this->numThreads = numThreads < 1 ? 1 : numThreads;
+
+    this->makespan = 0;
+
+    this->steals = 0;
+}
+
+/**
+ * Returns whether task a runs after task b, when both are ready
+ * The longer critical path first, ties to the lower task so runs are repeatable
+ *
+ * @param int a
+ * @param int b
+ * @return bool
+ */
+bool TaskScheduler::runsAfter(int a, int b)
+{
+    return this->rank[a] < this->rank[b] || (this->rank[a] == this->rank[b] && a > b);
+}
+
+/**
+ * Pushes task onto heap, the task to run first on top
+ *
+ * @param vector<int>& heap
+ * @param int task
+ * @return void
+ */
+void TaskScheduler::pushTask(vector<int>& heap, int task)
+{
+    heap.push_back(task);
+
+    push_heap(heap.begin(), heap.end(), [this](int a, int b) { return this->runsAfter(a, b); });
+}
+
+/**
+ * Removes and returns a ready task for thread t, -1 if there is none
+ * The top of its own heap if any, else the top with the longest critical path
+ * Among the heaps of the other threads
+ *
+ * @param int t
+ * @param vector<vector<int>>& heaps
+ * @param vector<mutex>& locks
+ * @return int
+ */
+int TaskScheduler::takeTask(int t, vector<vector<int>>& heaps, vector<mutex>& locks)
+{
+    for (int attempt=0; attempt<2; attempt++)
+    {
+        int victim = attempt == 0 ? t : -1, best = -1;
+
+        // Only peeks at the other heaps, their tops may be gone by the time the victim is locked
+        for (int v=0; attempt==1 && v<this->numThreads; v++)
+        {
+            if (v == t) continue;
+
+            int top;
+
+            {
+                lock_guard<mutex> guard(locks[v]);
+
+                if (heaps[v].empty()) continue;
+
+                top = heaps[v].front();
+            }
+
+            if (best == -1 || this->runsAfter(best, top))
+            {
+                victim = v;
+
+                best = top;
+            }
+        }
+
+        if (victim == -1) return -1;
+
+        lock_guard<mutex> guard(locks[victim]);
+
+        if (heaps[victim].empty()) continue;
+
+        pop_heap(heaps[victim].begin(), heaps[victim].end(), [this](int a, int b) { return this->runsAfter(a, b); });
+
+        int task = heaps[victim].back();
+
+        heaps[victim].pop_back();
+
+        if (victim != t) this->steals++;
+
+        return task;
+    }
+
+    return -1;
+}
+
+/**
+ * Runs task on every vertex, every task counted as the same time
+ *
+ * @param function<void(int)> task
+ * @return void
+ */
+void TaskScheduler::run(function<void(int)> task)
+{
+    vector<double> estimates(this->graph->getNumVertices(), 1);
+
+    this->run(task, estimates);
+}
+
+/**
+ * Runs task on every vertex, with estimates of the time of every task
+ * A task starts only after all of its dependencies finished
+ * Throws an error if the dependencies have a cycle, and throws again the first
+ * Error thrown by a task, once the tasks already running have finished
+ *
+ * @param function<void(int)> task
+ * @param vector<double>& estimates
+ * @return void
+ */
+void TaskScheduler::run(function<void(int)> task, vector<double>& estimates)
+{
+    int n = this->graph->getNumVertices();
+
+    if ((int) estimates.size() != n) throw "One estimate per task is needed";
+
+    // Every task comes before its dependencies, and throws on a cycle
+    vector<int> order = this->graph->topologicalSort();
+
+    this->graph->buildReverse();
+
+    // So the dependents of a task have their critical path by the time it is reached
+    this->rank.assign(n, 0);
+
+    for (int u : order)
+    {
+        double longest = 0;
+
+        for (int w : this->graph->reverseNeighbors(u)) longest = max(longest, this->rank[w]);
+
+        this->rank[u] = estimates[u] + longest;
+    }
+
+    this->startTimes.assign(n, 0);
+
+    this->finishTimes.assign(n, 0);
+
+    this->workers.assign(n, -1);
+
+    this->steals = 0;
+
+    vector<atomic<int>> pending(n);
+
+    vector<int> ready;
+
+    for (int u=0; u<n; u++)
+    {
+        pending[u] = this->graph->neighbors(u).size();
+
+        if (pending[u] == 0) ready.push_back(u);
+    }
+
+    sort(ready.begin(), ready.end(), [this](int a, int b) { return this->runsAfter(b, a); });
+
+    vector<vector<int>> heaps(this->numThreads);
+
+    vector<mutex> locks(this->numThreads);
+
+    // Dealt round robin, so every thread starts on one of the longest chains
+    for (size_t i=0; i<ready.size(); i++) this->pushTask(heaps[i % this->numThreads], ready[i]);
+
+    atomic<int> remaining(n), available(ready.size());
+
+    atomic<bool> failed(false);
+
+    exception_ptr error;
+
+    // Idle threads sleep on wake until a task is pushed, the run ends or a task throws
+    mutex idleLock;
+
+    condition_variable wake;
+
+    auto notifyIdle = [&]() {
+        {
+            lock_guard<mutex> guard(idleLock);
+        }
+
+        wake.notify_all();
+    };
+
+    auto start = chrono::steady_clock::now();
+
+    auto elapsed = [&]() {
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    };
+
+    auto work = [&](int t) {
+        while (remaining.load() > 0 && !failed.load())
+        {
+            int u = this->takeTask(t, heaps, locks);
+
+            if (u == -1)
+            {
+                unique_lock<mutex> guard(idleLock);
+
+                wake.wait(guard, [&]() { return available.load() > 0 || remaining.load() == 0 || failed.load(); });
+
+                continue;
+            }
+
+            available--;
+
+            this->workers[u] = t;
+
+            this->startTimes[u] = elapsed();
+
+            try
+            {
+                task(u);
+            }
+            catch (...)
+            {
+                // The first error is kept and thrown again once every thread is joined
+                {
+                    lock_guard<mutex> guard(idleLock);
+
+                    if (!failed.load()) error = current_exception();
+
+                    failed = true;
+                }
+
+                wake.notify_all();
+
+                return;
+            }
+
+            this->finishTimes[u] = elapsed();
+
+            int released = 0;
+
+            for (int w : this->graph->reverseNeighbors(u))
+            {
+                if (pending[w].fetch_sub(1) != 1) continue;
+
+                lock_guard<mutex> guard(locks[t]);
+
+                this->pushTask(heaps[t], w);
+
+                released++;
+            }
+
+            available += released;
+
+            if (--remaining == 0 || released > 0) notifyIdle();
+        }
+    };
+
+    vector<thread> pool;
+
+    for (int t=1; t<this->numThreads; t++) pool.push_back(thread(work, t));
+
+    work(0);
+
+    for (thread& th : pool) th.join();
+
+    this->makespan = elapsed();
+
+    if (error) rethrow_exception(error);
+}
+
+/**
+ * Returns the start time of every task of the last run, in milliseconds
+ *
+ * @return vector<double>
+ */
+vector<double> TaskScheduler::getStartTimes()
+{
+    return this->startTimes;
+}
+
+/**
+ * Returns the finish time of every task of the last run, in milliseconds
+ *
+ * @return vector<double>
+ */
+vector<double> TaskScheduler::getFinishTimes()
+{
+    return this->finishTimes;
+}
+
+/**
+ * Returns the thread that ran every task of the last run
+ *
+ * @return vector<int>
+ */
+vector<int> TaskScheduler::getWorkers()
+{
+    return this->workers;
+}
+
+/**
+ * Returns the time of the last run, in milliseconds
+ *
+ * @return double
+ */
+double TaskScheduler::getMakespan()
+{
+    return this->makespan;
+}
+
+/**
+ * Returns the longest chain of dependencies of the last run, in units of the estimates
+ *
+ * @return double
+ */
+double TaskScheduler::getCriticalPath()
+{
+    double longest = 0;
+
+    for (double r : this->rank) longest = max(longest, r);
+
+    return longest;
+}
+
+/**
+ * Returns the number of tasks stolen in the last run
+ *
+ * @return long long
+ */
+long long TaskScheduler::getNumSteals()
+{
+    return this->steals;
+}
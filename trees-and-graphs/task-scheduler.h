@@ -0,0 +1,180 @@
+#ifndef TASK_SCHEDULER
+#define TASK_SCHEDULER
+
+#include "directed-graph.h"
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <functional>
+
+using namespace std;
+
+/**
+ * Runs the tasks of a dependency graph on a pool of threads
+ * Vertices are tasks, and an edge (u, v) means u depends on v, as in build-order.cpp
+ * A task is ready once its count of unfinished dependencies drops to zero
+ * Every thread keeps its own heap of ready tasks, and pushes the tasks its own
+ * Finished task released there, so a chain of tasks tends to stay on one thread
+ * A thread whose heap is empty steals the best task on top of the other heaps,
+ * And sleeps while there is none to steal
+ * Heaps are ordered by critical path, the estimated time from the start of a
+ * Task to the end of the last task depending on it, so the longest chains
+ * Start first and the idle threads at the end are as few as possible
+ */
+class TaskScheduler
+{
+    private:
+        /**
+         * Dependency graph being run
+         *
+         * @param DirectedGraph* graph
+         */
+        DirectedGraph* graph;
+
+        /**
+         * Number of threads in the pool
+         *
+         * @param int numThreads
+         */
+        int numThreads;
+
+        /**
+         * Critical path of every task, in units of the estimates
+         *
+         * @param vector<double> rank
+         */
+        vector<double> rank;
+
+        /**
+         * Milliseconds from the start of the run to the start of every task
+         *
+         * @param vector<double> startTimes
+         */
+        vector<double> startTimes;
+
+        /**
+         * Milliseconds from the start of the run to the end of every task
+         *
+         * @param vector<double> finishTimes
+         */
+        vector<double> finishTimes;
+
+        /**
+         * Thread that ran every task
+         *
+         * @param vector<int> workers
+         */
+        vector<int> workers;
+
+        /**
+         * Milliseconds from the start of the run to the end of the last task
+         *
+         * @param double makespan
+         */
+        double makespan;
+
+        /**
+         * Number of tasks taken from the heap of another thread
+         *
+         * @param atomic<long long> steals
+         */
+        atomic<long long> steals;
+
+        /**
+         * Returns whether task a runs after task b, when both are ready
+         *
+         * @param int a
+         * @param int b
+         * @return bool
+         */
+        bool runsAfter(int a, int b);
+
+        /**
+         * Pushes task onto heap
+         *
+         * @param vector<int>& heap
+         * @param int task
+         * @return void
+         */
+        void pushTask(vector<int>& heap, int task);
+
+        /**
+         * Removes and returns a ready task for thread t, -1 if there is none
+         *
+         * @param int t
+         * @param vector<vector<int>>& heaps
+         * @param vector<mutex>& locks
+         * @return int
+         */
+        int takeTask(int t, vector<vector<int>>& heaps, vector<mutex>& locks);
+
+    public:
+        /**
+         * Creates a scheduler over graph with numThreads threads
+         *
+         * @param DirectedGraph& graph
+         * @param int numThreads
+         */
+        TaskScheduler(DirectedGraph& graph, int numThreads);
+
+        /**
+         * Runs task on every vertex, every task counted as the same time
+         *
+         * @param function<void(int)> task
+         * @return void
+         */
+        void run(function<void(int)> task);
+
+        /**
+         * Runs task on every vertex, with estimates of the time of every task
+         *
+         * @param function<void(int)> task
+         * @param vector<double>& estimates
+         * @return void
+         */
+        void run(function<void(int)> task, vector<double>& estimates);
+
+        /**
+         * Returns the start time of every task of the last run, in milliseconds
+         *
+         * @return vector<double>
+         */
+        vector<double> getStartTimes();
+
+        /**
+         * Returns the finish time of every task of the last run, in milliseconds
+         *
+         * @return vector<double>
+         */
+        vector<double> getFinishTimes();
+
+        /**
+         * Returns the thread that ran every task of the last run
+         *
+         * @return vector<int>
+         */
+        vector<int> getWorkers();
+
+        /**
+         * Returns the time of the last run, in milliseconds
+         *
+         * @return double
+         */
+        double getMakespan();
+
+        /**
+         * Returns the longest chain of dependencies of the last run, in units of the estimates
+         *
+         * @return double
+         */
+        double getCriticalPath();
+
+        /**
+         * Returns the number of tasks stolen in the last run
+         *
+         * @return long long
+         */
+        long long getNumSteals();
+};
+
+#endif
@@ -0,0 +1,771 @@
+#include "template-binary-search-tree.h"
+
+using namespace std;
+
+/**
+ * This is an implementation of a generic AVL ordered map
+ * Keys are only ever compared through compare(a, b), in both argument orders,
+ * So a transparent Compare lets lookups run on a Q without converting it to K
+ * Removal relinks nodes rather than copying keys, so extracted nodes and
+ * Pointers to values of other nodes stay valid
+ */
+
+/**
+ * Creates a leaf, moving in the key and value when given rvalues
+ *
+ * @param KK&& key
+ * @param VV&& value
+ */
+template <class K, class V>
+template <class KK, class VV>
+BSTNode<K, V>::BSTNode(KK&& key, VV&& value) : key(forward<KK>(key)), value(forward<VV>(value))
+{
+    this->height = 1;
+
+    this->size = 1;
+
+    this->left = nullptr;
+
+    this->right = nullptr;
+}
+
+/**
+ * Returns the key of the node
+ *
+ * @return const K&
+ */
+template <class K, class V>
+const K& BSTNode<K, V>::getKey()
+{
+    return this->key;
+}
+
+/**
+ * Returns the value of the node
+ *
+ * @return V&
+ */
+template <class K, class V>
+V& BSTNode<K, V>::getValue()
+{
+    return this->value;
+}
+
+/**
+ * Creates an empty handle
+ */
+template <class K, class V, class Compare>
+BST<K, V, Compare>::NodeHandle::NodeHandle()
+{
+    this->node = nullptr;
+}
+
+/**
+ * Takes the node of other
+ *
+ * @param NodeHandle&& other
+ */
+template <class K, class V, class Compare>
+BST<K, V, Compare>::NodeHandle::NodeHandle(NodeHandle&& other)
+{
+    this->node = other.node;
+
+    other.node = nullptr;
+}
+
+/**
+ * Takes the node of other, freeing the one held
+ *
+ * @param NodeHandle&& other
+ * @return NodeHandle&
+ */
+template <class K, class V, class Compare>
+typename BST<K, V, Compare>::NodeHandle& BST<K, V, Compare>::NodeHandle::operator=(NodeHandle&& other)
+{
+    if (this != &other)
+    {
+        delete this->node;
+
+        this->node = other.node;
+
+        other.node = nullptr;
+    }
+
+    return *this;
+}
+
+/**
+ * Frees the node, if still held
+ */
+template <class K, class V, class Compare>
+BST<K, V, Compare>::NodeHandle::~NodeHandle()
+{
+    delete this->node;
+}
+
+/**
+ * Returns whether the handle holds no node
+ *
+ * @return bool
+ */
+template <class K, class V, class Compare>
+bool BST<K, V, Compare>::NodeHandle::empty()
+{
+    return this->node == nullptr;
+}
+
+/**
+ * Returns the key of the held node
+ *
+ * @return K&
+ */
+template <class K, class V, class Compare>
+K& BST<K, V, Compare>::NodeHandle::key()
+{
+    return this->node->key;
+}
+
+/**
+ * Returns the value of the held node
+ *
+ * @return V&
+ */
+template <class K, class V, class Compare>
+V& BST<K, V, Compare>::NodeHandle::value()
+{
+    return this->node->value;
+}
+
+/**
+ * Creates an empty tree
+ *
+ * @param Compare compare
+ */
+template <class K, class V, class Compare>
+BST<K, V, Compare>::BST(Compare compare) : compare(compare)
+{
+    this->root = nullptr;
+}
+
+/**
+ * Frees every node of the tree
+ */
+template <class K, class V, class Compare>
+BST<K, V, Compare>::~BST()
+{
+    vector<BSTNode<K, V>*> stack;
+
+    if (this->root) stack.push_back(this->root);
+
+    while (!stack.empty())
+    {
+        BSTNode<K, V>* curr = stack.back();
+
+        stack.pop_back();
+
+        if (curr->left) stack.push_back(curr->left);
+
+        if (curr->right) stack.push_back(curr->right);
+
+        delete curr;
+    }
+}
+
+/**
+ * Returns the height of the tree rooted at curr
+ *
+ * @param BSTNode<K, V>* curr
+ * @return int
+ */
+template <class K, class V, class Compare>
+int BST<K, V, Compare>::heightOf(BSTNode<K, V>* curr)
+{
+    return curr ? curr->height : 0;
+}
+
+/**
+ * Returns the number of nodes in the tree rooted at curr
+ *
+ * @param BSTNode<K, V>* curr
+ * @return int
+ */
+template <class K, class V, class Compare>
+int BST<K, V, Compare>::sizeOf(BSTNode<K, V>* curr)
+{
+    return curr ? curr->size : 0;
+}
+
+/**
+ * Recomputes the height and size of curr from its children
+ *
+ * @param BSTNode<K, V>* curr
+ * @return void
+ */
+template <class K, class V, class Compare>
+void BST<K, V, Compare>::updateNode(BSTNode<K, V>* curr)
+{
+    curr->height = max(heightOf(curr->left), heightOf(curr->right)) + 1;
+
+    curr->size = sizeOf(curr->left) + sizeOf(curr->right) + 1;
+}
+
+/**
+ * Returns height(left) - height(right) of curr
+ *
+ * @param BSTNode<K, V>* curr
+ * @return int
+ */
+template <class K, class V, class Compare>
+int BST<K, V, Compare>::getBalanceFactor(BSTNode<K, V>* curr)
+{
+    return curr ? heightOf(curr->left) - heightOf(curr->right) : 0;
+}
+
+/**
+ * Rotates the tree rooted at curr to the left, returns the new root
+ *
+ * @param BSTNode<K, V>* curr
+ * @return BSTNode<K, V>*
+ */
+template <class K, class V, class Compare>
+BSTNode<K, V>* BST<K, V, Compare>::rotateLeft(BSTNode<K, V>* curr)
+{
+    BSTNode<K, V>* pivot = curr->right;
+
+    curr->right = pivot->left;
+
+    pivot->left = curr;
+
+    updateNode(curr);
+
+    updateNode(pivot);
+
+    return pivot;
+}
+
+/**
+ * Rotates the tree rooted at curr to the right, returns the new root
+ *
+ * @param BSTNode<K, V>* curr
+ * @return BSTNode<K, V>*
+ */
+template <class K, class V, class Compare>
+BSTNode<K, V>* BST<K, V, Compare>::rotateRight(BSTNode<K, V>* curr)
+{
+    BSTNode<K, V>* pivot = curr->left;
+
+    curr->left = pivot->right;
+
+    pivot->right = curr;
+
+    updateNode(curr);
+
+    updateNode(pivot);
+
+    return pivot;
+}
+
+/**
+ * Restores the AVL property at curr, returns the new root
+ *
+ * @param BSTNode<K, V>* curr
+ * @return BSTNode<K, V>*
+ */
+template <class K, class V, class Compare>
+BSTNode<K, V>* BST<K, V, Compare>::rebalance(BSTNode<K, V>* curr)
+{
+    updateNode(curr);
+
+    int balance = getBalanceFactor(curr);
+
+    if (balance > 1)
+    {
+        // Left-right case is reduced to the left-left case
+        if (getBalanceFactor(curr->left) < 0) curr->left = rotateLeft(curr->left);
+
+        return rotateRight(curr);
+    }
+    else if (balance < -1)
+    {
+        // Right-left case is reduced to the right-right case
+        if (getBalanceFactor(curr->right) > 0) curr->right = rotateRight(curr->right);
+
+        return rotateLeft(curr);
+    }
+
+    return curr;
+}
+
+/**
+ * Returns the node holding key, nullptr if there is none
+ *
+ * @param const Q& key
+ * @return BSTNode<K, V>*
+ */
+template <class K, class V, class Compare>
+template <class Q>
+BSTNode<K, V>* BST<K, V, Compare>::findNode(const Q& key)
+{
+    BSTNode<K, V>* curr = this->root;
+
+    while (curr)
+    {
+        if (this->compare(key, curr->key)) curr = curr->left;
+        else if (this->compare(curr->key, key)) curr = curr->right;
+        else return curr;
+    }
+
+    return nullptr;
+}
+
+/**
+ * Recursively inserts node, whose key isn't in the tree rooted at curr
+ * Returns the new root of the tree rooted at curr
+ *
+ * @param BSTNode<K, V>* curr
+ * @param BSTNode<K, V>* node
+ * @return BSTNode<K, V>*
+ */
+template <class K, class V, class Compare>
+BSTNode<K, V>* BST<K, V, Compare>::recursiveInsert(BSTNode<K, V>* curr, BSTNode<K, V>* node)
+{
+    if (!curr) return node;
+
+    if (this->compare(node->key, curr->key))
+    {
+        curr->left = this->recursiveInsert(curr->left, node);
+    }
+    else
+    {
+        curr->right = this->recursiveInsert(curr->right, node);
+    }
+
+    return rebalance(curr);
+}
+
+/**
+ * Unlinks the smallest node of the tree rooted at curr into min
+ * Returns the new root of the tree rooted at curr
+ *
+ * @param BSTNode<K, V>* curr
+ * @param BSTNode<K, V>*& min
+ * @return BSTNode<K, V>*
+ */
+template <class K, class V, class Compare>
+BSTNode<K, V>* BST<K, V, Compare>::removeMin(BSTNode<K, V>* curr, BSTNode<K, V>*& min)
+{
+    if (!curr->left)
+    {
+        min = curr;
+
+        return curr->right;
+    }
+
+    curr->left = removeMin(curr->left, min);
+
+    return rebalance(curr);
+}
+
+/**
+ * Recursively unlinks the node holding key into removed
+ * Returns the new root of the tree rooted at curr
+ *
+ * @param BSTNode<K, V>* curr
+ * @param const Q& key
+ * @param BSTNode<K, V>*& removed
+ * @return BSTNode<K, V>*
+ */
+template <class K, class V, class Compare>
+template <class Q>
+BSTNode<K, V>* BST<K, V, Compare>::recursiveRemove(BSTNode<K, V>* curr, const Q& key, BSTNode<K, V>*& removed)
+{
+    if (!curr) return curr;
+
+    if (this->compare(key, curr->key))
+    {
+        curr->left = this->recursiveRemove(curr->left, key, removed);
+    }
+    else if (this->compare(curr->key, key))
+    {
+        curr->right = this->recursiveRemove(curr->right, key, removed);
+    }
+    else
+    {
+        removed = curr;
+
+        if (!curr->left || !curr->right) return curr->left ? curr->left : curr->right;
+
+        // The successor node takes the place of curr
+        BSTNode<K, V>* successor;
+
+        BSTNode<K, V>* right = removeMin(curr->right, successor);
+
+        successor->left = curr->left;
+
+        successor->right = right;
+
+        curr = successor;
+    }
+
+    return rebalance(curr);
+}
+
+/**
+ * Unlinks and returns the node holding key, nullptr if there is none
+ *
+ * @param const Q& key
+ * @return BSTNode<K, V>*
+ */
+template <class K, class V, class Compare>
+template <class Q>
+BSTNode<K, V>* BST<K, V, Compare>::detach(const Q& key)
+{
+    BSTNode<K, V>* removed = nullptr;
+
+    this->root = this->recursiveRemove(this->root, key, removed);
+
+    if (removed)
+    {
+        removed->left = nullptr;
+
+        removed->right = nullptr;
+
+        updateNode(removed);
+    }
+
+    return removed;
+}
+
+/**
+ * Returns the number of keys less than key
+ *
+ * @param const Q& key
+ * @return int
+ */
+template <class K, class V, class Compare>
+template <class Q>
+int BST<K, V, Compare>::countBelow(const Q& key)
+{
+    int count = 0;
+
+    BSTNode<K, V>* curr = this->root;
+
+    while (curr)
+    {
+        if (this->compare(curr->key, key))
+        {
+            count += 1 + sizeOf(curr->left);
+
+            curr = curr->right;
+        }
+        else
+        {
+            curr = curr->left;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Maps key to value if key isn't in the tree yet, returns whether it was inserted
+ * Rvalue keys and values are moved into the node
+ *
+ * @param KK&& key
+ * @param VV&& value
+ * @return bool
+ */
+template <class K, class V, class Compare>
+template <class KK, class VV>
+bool BST<K, V, Compare>::insert(KK&& key, VV&& value)
+{
+    BSTNode<K, V>* node;
+
+    if constexpr (is_same<typename decay<KK>::type, K>::value)
+    {
+        // Checked first, so a rejected key and value are never moved from
+        if (this->findNode(key)) return false;
+
+        node = new BSTNode<K, V>(forward<KK>(key), forward<VV>(value));
+    }
+    else
+    {
+        // Other key types are converted once, not on every comparison
+        node = new BSTNode<K, V>(forward<KK>(key), forward<VV>(value));
+
+        if (this->findNode(node->key))
+        {
+            delete node;
+
+            return false;
+        }
+    }
+
+    this->root = this->recursiveInsert(this->root, node);
+
+    return true;
+}
+
+/**
+ * Inserts the node held by handle if its key isn't in the tree yet
+ * On success the handle is left empty, otherwise it keeps the node
+ *
+ * @param NodeHandle&& handle
+ * @return bool
+ */
+template <class K, class V, class Compare>
+bool BST<K, V, Compare>::insert(NodeHandle&& handle)
+{
+    if (handle.empty() || this->findNode(handle.node->key)) return false;
+
+    this->root = this->recursiveInsert(this->root, handle.node);
+
+    handle.node = nullptr;
+
+    return true;
+}
+
+/**
+ * Returns the value mapped to by key, nullptr if there is none
+ *
+ * @param const K& key
+ * @return V*
+ */
+template <class K, class V, class Compare>
+V* BST<K, V, Compare>::find(const K& key)
+{
+    BSTNode<K, V>* node = this->findNode(key);
+
+    return node ? &node->value : nullptr;
+}
+
+/**
+ * Returns the value mapped to by a key comparing equal to key
+ * Only available for a transparent Compare
+ *
+ * @param const Q& key
+ * @return V*
+ */
+template <class K, class V, class Compare>
+template <class Q, class C, class>
+V* BST<K, V, Compare>::find(const Q& key)
+{
+    BSTNode<K, V>* node = this->findNode(key);
+
+    return node ? &node->value : nullptr;
+}
+
+/**
+ * Checks whether key exists in the tree
+ *
+ * @param const K& key
+ * @return bool
+ */
+template <class K, class V, class Compare>
+bool BST<K, V, Compare>::exists(const K& key)
+{
+    return this->findNode(key) != nullptr;
+}
+
+/**
+ * Checks whether a key comparing equal to key exists in the tree
+ * Only available for a transparent Compare
+ *
+ * @param const Q& key
+ * @return bool
+ */
+template <class K, class V, class Compare>
+template <class Q, class C, class>
+bool BST<K, V, Compare>::exists(const Q& key)
+{
+    return this->findNode(key) != nullptr;
+}
+
+/**
+ * Removes key from the tree, returns whether it was there
+ *
+ * @param const K& key
+ * @return bool
+ */
+template <class K, class V, class Compare>
+bool BST<K, V, Compare>::remove(const K& key)
+{
+    BSTNode<K, V>* removed = this->detach(key);
+
+    delete removed;
+
+    return removed != nullptr;
+}
+
+/**
+ * Removes a key comparing equal to key, returns whether there was one
+ * Only available for a transparent Compare
+ *
+ * @param const Q& key
+ * @return bool
+ */
+template <class K, class V, class Compare>
+template <class Q, class C, class>
+bool BST<K, V, Compare>::remove(const Q& key)
+{
+    BSTNode<K, V>* removed = this->detach(key);
+
+    delete removed;
+
+    return removed != nullptr;
+}
+
+/**
+ * Takes the node holding key out of the tree, without copying or freeing it
+ * The handle is empty if key isn't in the tree
+ *
+ * @param const K& key
+ * @return NodeHandle
+ */
+template <class K, class V, class Compare>
+typename BST<K, V, Compare>::NodeHandle BST<K, V, Compare>::extract(const K& key)
+{
+    NodeHandle handle;
+
+    handle.node = this->detach(key);
+
+    return handle;
+}
+
+/**
+ * Takes the node holding a key comparing equal to key out of the tree
+ * Only available for a transparent Compare
+ *
+ * @param const Q& key
+ * @return NodeHandle
+ */
+template <class K, class V, class Compare>
+template <class Q, class C, class>
+typename BST<K, V, Compare>::NodeHandle BST<K, V, Compare>::extract(const Q& key)
+{
+    NodeHandle handle;
+
+    handle.node = this->detach(key);
+
+    return handle;
+}
+
+/**
+ * Returns the rank key has or would have once inserted, 1 for the smallest key
+ * So getNthRank(rankOf(key)) holds key when key is in the tree
+ *
+ * @param const K& key
+ * @return int
+ */
+template <class K, class V, class Compare>
+int BST<K, V, Compare>::rankOf(const K& key)
+{
+    return this->countBelow(key) + 1;
+}
+
+/**
+ * Returns the rank key has or would have once inserted, 1 for the smallest key
+ * So getNthRank(rankOf(key)) holds key when key is in the tree
+ * Only available for a transparent Compare
+ *
+ * @param const Q& key
+ * @return int
+ */
+template <class K, class V, class Compare>
+template <class Q, class C, class>
+int BST<K, V, Compare>::rankOf(const Q& key)
+{
+    return this->countBelow(key) + 1;
+}
+
+/**
+ * Gets the node with the nth smallest key
+ * n must be in the range [1, numVertices]
+ *
+ * @param int n
+ * @return BSTNode<K, V>*
+ */
+template <class K, class V, class Compare>
+BSTNode<K, V>* BST<K, V, Compare>::getNthRank(int n)
+{
+    BSTNode<K, V>* curr = this->root;
+
+    while (curr)
+    {
+        int leftSize = sizeOf(curr->left);
+
+        if (n <= leftSize)
+        {
+            curr = curr->left;
+        }
+        else if (n == leftSize + 1)
+        {
+            return curr;
+        }
+        else
+        {
+            n -= leftSize + 1;
+
+            curr = curr->right;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * Returns the number of keys in the tree
+ *
+ * @return int
+ */
+template <class K, class V, class Compare>
+int BST<K, V, Compare>::getNumVertices()
+{
+    return sizeOf(this->root);
+}
+
+/**
+ * Returns the height of the tree
+ *
+ * @return int
+ */
+template <class K, class V, class Compare>
+int BST<K, V, Compare>::getHeight()
+{
+    return heightOf(this->root);
+}
+
+/**
+ * Returns the keys of the tree inOrder
+ *
+ * @return vector<K>
+ */
+template <class K, class V, class Compare>
+vector<K> BST<K, V, Compare>::inOrder()
+{
+    vector<K> res;
+
+    vector<BSTNode<K, V>*> stack;
+
+    BSTNode<K, V>* curr = this->root;
+
+    while (curr || !stack.empty())
+    {
+        while (curr)
+        {
+            stack.push_back(curr);
+
+            curr = curr->left;
+        }
+
+        curr = stack.back();
+
+        stack.pop_back();
+
+        res.push_back(curr->key);
+
+        curr = curr->right;
+    }
+
+    return res;
+}
@@ -0,0 +1,450 @@
+#ifndef TEMPLATE_BINARY_SEARCH_TREE
+#define TEMPLATE_BINARY_SEARCH_TREE
+
+#include <vector>
+#include <utility>
+#include <functional>
+#include <type_traits>
+
+using namespace std;
+
+template <class K, class V>
+class BSTNode
+{
+    public:
+        /**
+         * Key the node is ordered by
+         *
+         * @param K key
+         */
+        K key;
+
+        /**
+         * Value mapped to by the key
+         *
+         * @param V value
+         */
+        V value;
+
+        /**
+         * Height of the tree rooted at this node
+         *
+         * @param int height
+         */
+        int height;
+
+        /**
+         * Number of nodes in the tree rooted at this node
+         *
+         * @param int size
+         */
+        int size;
+
+        /**
+         * Left child of the node
+         *
+         * @param BSTNode<K, V>* left
+         */
+        BSTNode<K, V>* left;
+
+        /**
+         * Right child of the node
+         *
+         * @param BSTNode<K, V>* right
+         */
+        BSTNode<K, V>* right;
+
+        /**
+         * Creates a leaf, moving in the key and value when given rvalues
+         *
+         * @param KK&& key
+         * @param VV&& value
+         */
+        template <class KK, class VV>
+        BSTNode(KK&& key, VV&& value);
+
+        /**
+         * Returns the key of the node
+         *
+         * @return const K&
+         */
+        const K& getKey();
+
+        /**
+         * Returns the value of the node
+         *
+         * @return V&
+         */
+        V& getValue();
+};
+
+/**
+ * AVL ordered map from K to V, keys are unique
+ * Nodes keep their height and subtree size, so rank queries take O(log n)
+ * With a transparent Compare, such as less<>, lookups take any type comparable
+ * To K, for example a string_view for string keys, without building a K
+ */
+template <class K, class V, class Compare = less<K>>
+class BST
+{
+    public:
+        /**
+         * Owns a node taken out of the tree, until it is inserted again
+         * The key may be changed while the node is out of the tree
+         */
+        class NodeHandle
+        {
+            private:
+                /**
+                 * Detached node, nullptr when empty
+                 *
+                 * @param BSTNode<K, V>* node
+                 */
+                BSTNode<K, V>* node;
+
+                friend class BST;
+
+            public:
+                /**
+                 * Creates an empty handle
+                 */
+                NodeHandle();
+
+                /**
+                 * Takes the node of other
+                 *
+                 * @param NodeHandle&& other
+                 */
+                NodeHandle(NodeHandle&& other);
+
+                /**
+                 * Takes the node of other, freeing the one held
+                 *
+                 * @param NodeHandle&& other
+                 * @return NodeHandle&
+                 */
+                NodeHandle& operator=(NodeHandle&& other);
+
+                NodeHandle(const NodeHandle& other) = delete;
+
+                NodeHandle& operator=(const NodeHandle& other) = delete;
+
+                /**
+                 * Frees the node, if still held
+                 */
+                ~NodeHandle();
+
+                /**
+                 * Returns whether the handle holds no node
+                 *
+                 * @return bool
+                 */
+                bool empty();
+
+                /**
+                 * Returns the key of the held node
+                 *
+                 * @return K&
+                 */
+                K& key();
+
+                /**
+                 * Returns the value of the held node
+                 *
+                 * @return V&
+                 */
+                V& value();
+        };
+
+    private:
+        /**
+         * Root of the tree
+         *
+         * @param BSTNode<K, V>* root
+         */
+        BSTNode<K, V>* root;
+
+        /**
+         * Strict weak ordering of the keys
+         *
+         * @param Compare compare
+         */
+        Compare compare;
+
+        /**
+         * Returns the height of the tree rooted at curr
+         *
+         * @param BSTNode<K, V>* curr
+         * @return int
+         */
+        static int heightOf(BSTNode<K, V>* curr);
+
+        /**
+         * Returns the number of nodes in the tree rooted at curr
+         *
+         * @param BSTNode<K, V>* curr
+         * @return int
+         */
+        static int sizeOf(BSTNode<K, V>* curr);
+
+        /**
+         * Recomputes the height and size of curr from its children
+         *
+         * @param BSTNode<K, V>* curr
+         * @return void
+         */
+        static void updateNode(BSTNode<K, V>* curr);
+
+        /**
+         * Returns height(left) - height(right) of curr
+         *
+         * @param BSTNode<K, V>* curr
+         * @return int
+         */
+        static int getBalanceFactor(BSTNode<K, V>* curr);
+
+        /**
+         * Rotates the tree rooted at curr to the left, returns the new root
+         *
+         * @param BSTNode<K, V>* curr
+         * @return BSTNode<K, V>*
+         */
+        static BSTNode<K, V>* rotateLeft(BSTNode<K, V>* curr);
+
+        /**
+         * Rotates the tree rooted at curr to the right, returns the new root
+         *
+         * @param BSTNode<K, V>* curr
+         * @return BSTNode<K, V>*
+         */
+        static BSTNode<K, V>* rotateRight(BSTNode<K, V>* curr);
+
+        /**
+         * Restores the AVL property at curr, returns the new root
+         *
+         * @param BSTNode<K, V>* curr
+         * @return BSTNode<K, V>*
+         */
+        static BSTNode<K, V>* rebalance(BSTNode<K, V>* curr);
+
+        /**
+         * Returns the node holding key, nullptr if there is none
+         *
+         * @param const Q& key
+         * @return BSTNode<K, V>*
+         */
+        template <class Q>
+        BSTNode<K, V>* findNode(const Q& key);
+
+        /**
+         * Recursively inserts node, whose key isn't in the tree rooted at curr
+         * Returns the new root of the tree rooted at curr
+         *
+         * @param BSTNode<K, V>* curr
+         * @param BSTNode<K, V>* node
+         * @return BSTNode<K, V>*
+         */
+        BSTNode<K, V>* recursiveInsert(BSTNode<K, V>* curr, BSTNode<K, V>* node);
+
+        /**
+         * Unlinks the smallest node of the tree rooted at curr into min
+         * Returns the new root of the tree rooted at curr
+         *
+         * @param BSTNode<K, V>* curr
+         * @param BSTNode<K, V>*& min
+         * @return BSTNode<K, V>*
+         */
+        static BSTNode<K, V>* removeMin(BSTNode<K, V>* curr, BSTNode<K, V>*& min);
+
+        /**
+         * Recursively unlinks the node holding key into removed
+         * Returns the new root of the tree rooted at curr
+         *
+         * @param BSTNode<K, V>* curr
+         * @param const Q& key
+         * @param BSTNode<K, V>*& removed
+         * @return BSTNode<K, V>*
+         */
+        template <class Q>
+        BSTNode<K, V>* recursiveRemove(BSTNode<K, V>* curr, const Q& key, BSTNode<K, V>*& removed);
+
+        /**
+         * Unlinks and returns the node holding key, nullptr if there is none
+         *
+         * @param const Q& key
+         * @return BSTNode<K, V>*
+         */
+        template <class Q>
+        BSTNode<K, V>* detach(const Q& key);
+
+        /**
+         * Returns the number of keys less than key
+         *
+         * @param const Q& key
+         * @return int
+         */
+        template <class Q>
+        int countBelow(const Q& key);
+
+    public:
+        /**
+         * Creates an empty tree
+         *
+         * @param Compare compare
+         */
+        BST(Compare compare = Compare());
+
+        BST(const BST& other) = delete;
+
+        BST& operator=(const BST& other) = delete;
+
+        /**
+         * Frees every node of the tree
+         */
+        ~BST();
+
+        /**
+         * Maps key to value if key isn't in the tree yet, returns whether it was inserted
+         * Rvalue keys and values are moved into the node
+         *
+         * @param KK&& key
+         * @param VV&& value
+         * @return bool
+         */
+        template <class KK, class VV>
+        bool insert(KK&& key, VV&& value);
+
+        /**
+         * Inserts the node held by handle if its key isn't in the tree yet
+         * On success the handle is left empty, otherwise it keeps the node
+         *
+         * @param NodeHandle&& handle
+         * @return bool
+         */
+        bool insert(NodeHandle&& handle);
+
+        /**
+         * Returns the value mapped to by key, nullptr if there is none
+         *
+         * @param const K& key
+         * @return V*
+         */
+        V* find(const K& key);
+
+        /**
+         * Returns the value mapped to by a key comparing equal to key
+         * Only available for a transparent Compare
+         *
+         * @param const Q& key
+         * @return V*
+         */
+        template <class Q, class C = Compare, class = typename C::is_transparent>
+        V* find(const Q& key);
+
+        /**
+         * Checks whether key exists in the tree
+         *
+         * @param const K& key
+         * @return bool
+         */
+        bool exists(const K& key);
+
+        /**
+         * Checks whether a key comparing equal to key exists in the tree
+         * Only available for a transparent Compare
+         *
+         * @param const Q& key
+         * @return bool
+         */
+        template <class Q, class C = Compare, class = typename C::is_transparent>
+        bool exists(const Q& key);
+
+        /**
+         * Removes key from the tree, returns whether it was there
+         *
+         * @param const K& key
+         * @return bool
+         */
+        bool remove(const K& key);
+
+        /**
+         * Removes a key comparing equal to key, returns whether there was one
+         * Only available for a transparent Compare
+         *
+         * @param const Q& key
+         * @return bool
+         */
+        template <class Q, class C = Compare, class = typename C::is_transparent>
+        bool remove(const Q& key);
+
+        /**
+         * Takes the node holding key out of the tree, without copying or freeing it
+         * The handle is empty if key isn't in the tree
+         *
+         * @param const K& key
+         * @return NodeHandle
+         */
+        NodeHandle extract(const K& key);
+
+        /**
+         * Takes the node holding a key comparing equal to key out of the tree
+         * Only available for a transparent Compare
+         *
+         * @param const Q& key
+         * @return NodeHandle
+         */
+        template <class Q, class C = Compare, class = typename C::is_transparent>
+        NodeHandle extract(const Q& key);
+
+        /**
+         * Returns the rank key has or would have once inserted, 1 for the smallest key
+         * So getNthRank(rankOf(key)) holds key when key is in the tree
+         *
+         * @param const K& key
+         * @return int
+         */
+        int rankOf(const K& key);
+
+        /**
+         * Returns the rank key has or would have once inserted, 1 for the smallest key
+         * So getNthRank(rankOf(key)) holds key when key is in the tree
+         * Only available for a transparent Compare
+         *
+         * @param const Q& key
+         * @return int
+         */
+        template <class Q, class C = Compare, class = typename C::is_transparent>
+        int rankOf(const Q& key);
+
+        /**
+         * Gets the node with the nth smallest key
+         * n must be in the range [1, numVertices]
+         *
+         * @param int n
+         * @return BSTNode<K, V>*
+         */
+        BSTNode<K, V>* getNthRank(int n);
+
+        /**
+         * Returns the number of keys in the tree
+         *
+         * @return int
+         */
+        int getNumVertices();
+
+        /**
+         * Returns the height of the tree
+         *
+         * @return int
+         */
+        int getHeight();
+
+        /**
+         * Returns the keys of the tree inOrder
+         *
+         * @return vector<K>
+         */
+        vector<K> inOrder();
+};
+
+#endif
@@ -1,4 +1,7 @@
+#include "template-binary-search-tree.cpp"
 #include <iostream>
+#include <string>
+#include <string_view>
 
 using namespace std;
 
@@ -53,4 +56,32 @@ int main()
     cout << node2->getValue() << endl;
 
     cout << node3->getValue() << endl;
+
+    // less<> is transparent, so string_view lookups don't build a string
+    BST<string, int, less<>> index;
+
+    string name = "mayank";
+
+    index.insert(move(name), 1);
+
+    index.insert(string("ada"), 2);
+
+    index.insert(string("grace"), 3);
+
+    string_view query = "grace";
+
+    cout << *index.find(query) << " " << index.rankOf(query) << endl;
+
+    cout << index.getNthRank(1)->getKey() << " " << index.getHeight() << endl;
+
+    // The node moves between keys without being copied or reallocated
+    BST<string, int, less<>>::NodeHandle handle = index.extract(string_view("ada"));
+
+    handle.key() = "zoe";
+
+    index.insert(move(handle));
+
+    for (string& key : index.inOrder()) cout << key << " ";
+
+    cout << endl;
 }
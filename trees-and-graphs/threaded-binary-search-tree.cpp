@@ -0,0 +1,383 @@
+#include "threaded-binary-search-tree.h"
+
+using namespace std;
+
+/**
+ * This is an implementation of a right threaded BST
+ * A node without a right child is the largest of some left subtree, or the
+ * Last node, so its successor is the parent of that subtree, which its right
+ * Pointer holds instead. Going right is then a single link, and going to the
+ * Successor through a child descends the left spine of that child once
+ */
+
+/**
+ * Creates a ThreadedTreeNode* with no children, threaded to successor
+ *
+ * @param int val
+ * @param ThreadedTreeNode* successor
+ */
+ThreadedTreeNode::ThreadedTreeNode(int val, ThreadedTreeNode* successor)
+{
+    this->value = val;
+
+    this->left = nullptr;
+
+    this->right = successor;
+
+    this->rightThread = true;
+}
+
+/**
+ * Returns the value stored at the node
+ *
+ * @return int
+ */
+int ThreadedTreeNode::getValue()
+{
+    return this->value;
+}
+
+/**
+ * Creates an empty threaded Binary Search Tree
+ */
+ThreadedBinarySearchTree::ThreadedBinarySearchTree()
+{
+    this->size = 0;
+
+    this->root = nullptr;
+}
+
+/**
+ * Inserts a new node into the Binary Search Tree
+ * A new left leaf is threaded to its parent, a new right leaf takes over the
+ * Thread of its parent
+ *
+ * @param int val
+ * @return void
+ */
+void ThreadedBinarySearchTree::insert(int val)
+{
+    this->size++;
+
+    if (!this->root)
+    {
+        this->root = new ThreadedTreeNode(val, nullptr);
+
+        return;
+    }
+
+    ThreadedTreeNode* curr = this->root;
+
+    while (true)
+    {
+        if (curr->value >= val)
+        {
+            if (!curr->left)
+            {
+                curr->left = new ThreadedTreeNode(val, curr);
+
+                return;
+            }
+
+            curr = curr->left;
+        }
+        else
+        {
+            if (curr->rightThread)
+            {
+                curr->right = new ThreadedTreeNode(val, curr->right);
+
+                curr->rightThread = false;
+
+                return;
+            }
+
+            curr = curr->right;
+        }
+    }
+}
+
+/**
+ * Unlinks node, which has no left child or no right child, from parent
+ * No thread points at such a node unless it has a left child, in which case
+ * The largest node of the left subtree is threaded past it
+ *
+ * @param ThreadedTreeNode* parent
+ * @param ThreadedTreeNode* node
+ * @return void
+ */
+void ThreadedBinarySearchTree::unlink(ThreadedTreeNode* parent, ThreadedTreeNode* node)
+{
+    ThreadedTreeNode* child;
+
+    if (node->left)
+    {
+        ThreadedTreeNode* predecessor = node->left;
+
+        while (!predecessor->rightThread) predecessor = predecessor->right;
+
+        predecessor->right = node->right;
+
+        child = node->left;
+    }
+    else
+    {
+        child = node->rightThread ? nullptr : node->right;
+    }
+
+    if (!parent)
+    {
+        this->root = child;
+    }
+    else if (parent->left == node)
+    {
+        parent->left = child;
+    }
+    else if (child)
+    {
+        parent->right = child;
+    }
+    else
+    {
+        // parent becomes the largest of its subtree, so it inherits the thread
+        parent->right = node->right;
+
+        parent->rightThread = true;
+    }
+
+    delete node;
+}
+
+/**
+ * Removes one node holding val, returns whether a node was removed
+ *
+ * @param int val
+ * @return bool
+ */
+bool ThreadedBinarySearchTree::remove(int val)
+{
+    ThreadedTreeNode* parent = nullptr;
+
+    ThreadedTreeNode* curr = this->root;
+
+    while (curr && curr->value != val)
+    {
+        parent = curr;
+
+        if (curr->value > val) curr = curr->left;
+        else curr = curr->rightThread ? nullptr : curr->right;
+    }
+
+    if (!curr) return false;
+
+    if (curr->left && !curr->rightThread)
+    {
+        // Two children, so curr takes over the value of its in order successor
+        ThreadedTreeNode* successorParent = curr;
+
+        ThreadedTreeNode* successor = curr->right;
+
+        while (successor->left)
+        {
+            successorParent = successor;
+
+            successor = successor->left;
+        }
+
+        curr->value = successor->value;
+
+        parent = successorParent;
+
+        curr = successor;
+    }
+
+    this->unlink(parent, curr);
+
+    this->size--;
+
+    return true;
+}
+
+/**
+ * Links nodes[lo..hi], which hold sorted values, into a balanced tree
+ * Returns its root
+ *
+ * @param vector<ThreadedTreeNode*>& nodes
+ * @param int lo
+ * @param int hi
+ * @return ThreadedTreeNode*
+ */
+ThreadedTreeNode* ThreadedBinarySearchTree::linkBalanced(vector<ThreadedTreeNode*>& nodes, int lo, int hi)
+{
+    if (lo > hi) return nullptr;
+
+    int mid = lo + (hi - lo) / 2;
+
+    ThreadedTreeNode* node = nodes[mid];
+
+    node->left = linkBalanced(nodes, lo, mid-1);
+
+    ThreadedTreeNode* right = linkBalanced(nodes, mid+1, hi);
+
+    // Without a right subtree the thread to the next node in order stays
+    if (right)
+    {
+        node->right = right;
+
+        node->rightThread = false;
+    }
+
+    return node;
+}
+
+/**
+ * Replaces the contents of the tree with values sorted in increasing order
+ * Builds a balanced tree in O(n)
+ *
+ * @param vector<int>& sorted
+ * @return void
+ */
+void ThreadedBinarySearchTree::bulkLoad(vector<int>& sorted)
+{
+    int n = sorted.size();
+
+    vector<ThreadedTreeNode*> nodes(n);
+
+    for (int i=n-1; i>=0; i--) nodes[i] = new ThreadedTreeNode(sorted[i], i+1 < n ? nodes[i+1] : nullptr);
+
+    this->root = linkBalanced(nodes, 0, n-1);
+
+    this->size = n;
+}
+
+/**
+ * Checks whether a value exists in the BST
+ *
+ * @param int val
+ * @return bool
+ */
+bool ThreadedBinarySearchTree::exists(int val)
+{
+    ThreadedTreeNode* curr = this->root;
+
+    while (curr && curr->value != val)
+    {
+        if (curr->value > val) curr = curr->left;
+        else curr = curr->rightThread ? nullptr : curr->right;
+    }
+
+    return curr != nullptr;
+}
+
+/**
+ * Returns the number of vertices in the BST
+ *
+ * @return int
+ */
+int ThreadedBinarySearchTree::getNumVertices()
+{
+    return this->size;
+}
+
+/**
+ * Returns the root of the bst
+ *
+ * @return ThreadedTreeNode*
+ */
+ThreadedTreeNode* ThreadedBinarySearchTree::getRoot()
+{
+    return this->root;
+}
+
+/**
+ * Returns the first node in order, nullptr for an empty tree
+ *
+ * @return ThreadedTreeNode*
+ */
+ThreadedTreeNode* ThreadedBinarySearchTree::first()
+{
+    ThreadedTreeNode* curr = this->root;
+
+    while (curr && curr->left) curr = curr->left;
+
+    return curr;
+}
+
+/**
+ * Returns the first node holding a value not less than val, nullptr if none
+ *
+ * @param int val
+ * @return ThreadedTreeNode*
+ */
+ThreadedTreeNode* ThreadedBinarySearchTree::lowerBound(int val)
+{
+    ThreadedTreeNode* res = nullptr;
+
+    ThreadedTreeNode* curr = this->root;
+
+    while (curr)
+    {
+        if (curr->value >= val)
+        {
+            res = curr;
+
+            curr = curr->left;
+        }
+        else
+        {
+            curr = curr->rightThread ? nullptr : curr->right;
+        }
+    }
+
+    return res;
+}
+
+/**
+ * Returns the in order successor of node, nullptr for the last node
+ * O(1) amortized over a scan
+ *
+ * @param ThreadedTreeNode* node
+ * @return ThreadedTreeNode*
+ */
+ThreadedTreeNode* ThreadedBinarySearchTree::getSuccessor(ThreadedTreeNode* node)
+{
+    if (node->rightThread) return node->right;
+
+    ThreadedTreeNode* curr = node->right;
+
+    while (curr->left) curr = curr->left;
+
+    return curr;
+}
+
+/**
+ * Appends the values in the range [lo, hi] to res in order
+ *
+ * @param int lo
+ * @param int hi
+ * @param vector<int>& res
+ * @return void
+ */
+void ThreadedBinarySearchTree::rangeScan(int lo, int hi, vector<int>& res)
+{
+    for (ThreadedTreeNode* curr = this->lowerBound(lo); curr && curr->value <= hi; curr = getSuccessor(curr))
+    {
+        res.push_back(curr->value);
+    }
+}
+
+/**
+ * Returns the entire tree inOrder
+ *
+ * @return vector<int>
+ */
+vector<int> ThreadedBinarySearchTree::inOrder()
+{
+    vector<int> res;
+
+    res.reserve(this->size);
+
+    for (ThreadedTreeNode* curr = this->first(); curr; curr = getSuccessor(curr)) res.push_back(curr->value);
+
+    return res;
+}
@@ -0,0 +1,195 @@
+#ifndef THREADED_BINARY_SEARCH_TREE
+#define THREADED_BINARY_SEARCH_TREE
+
+#include <vector>
+
+using namespace std;
+
+class ThreadedTreeNode
+{
+    public:
+        /**
+         * Value held at the node
+         *
+         * @param int value
+         */
+        int value;
+
+        /**
+         * Whether right is a thread to the in order successor rather than a child
+         *
+         * @param bool rightThread
+         */
+        bool rightThread;
+
+        /**
+         * Left child of the node
+         *
+         * @param ThreadedTreeNode* left
+         */
+        ThreadedTreeNode* left;
+
+        /**
+         * Right child of the node, or its in order successor if rightThread
+         * nullptr only for the last node in order
+         *
+         * @param ThreadedTreeNode* right
+         */
+        ThreadedTreeNode* right;
+
+        /**
+         * Creates a ThreadedTreeNode* with no children, threaded to successor
+         *
+         * @param int val
+         * @param ThreadedTreeNode* successor
+         */
+        ThreadedTreeNode(int val, ThreadedTreeNode* successor);
+
+        /**
+         * Returns the value stored at the node
+         *
+         * @return int
+         */
+        int getValue();
+};
+
+/**
+ * Right threaded Binary Search Tree
+ * A missing right child is replaced by a thread to the in order successor,
+ * So walking the tree in order needs neither a stack nor parent pointers,
+ * And a full scan follows each link exactly once
+ * The tree isn't rebalanced, bulkLoad builds a balanced tree from sorted values
+ */
+class ThreadedBinarySearchTree
+{
+    private:
+        /**
+         * Number of elements in the BST
+         *
+         * @param int size
+         */
+        int size;
+
+        /**
+         * Root of the Binary Search Tree
+         *
+         * @param ThreadedTreeNode* root
+         */
+        ThreadedTreeNode* root;
+
+        /**
+         * Links nodes[lo..hi], which hold sorted values, into a balanced tree
+         * Returns its root
+         *
+         * @param vector<ThreadedTreeNode*>& nodes
+         * @param int lo
+         * @param int hi
+         * @return ThreadedTreeNode*
+         */
+        static ThreadedTreeNode* linkBalanced(vector<ThreadedTreeNode*>& nodes, int lo, int hi);
+
+        /**
+         * Unlinks node, which has no left child or no right child, from parent
+         *
+         * @param ThreadedTreeNode* parent
+         * @param ThreadedTreeNode* node
+         * @return void
+         */
+        void unlink(ThreadedTreeNode* parent, ThreadedTreeNode* node);
+
+    public:
+        /**
+         * Creates an empty threaded Binary Search Tree
+         */
+        ThreadedBinarySearchTree();
+
+        /**
+         * Inserts a new node into the Binary Search Tree
+         *
+         * @param int val
+         * @return void
+         */
+        void insert(int val);
+
+        /**
+         * Removes one node holding val, returns whether a node was removed
+         *
+         * @param int val
+         * @return bool
+         */
+        bool remove(int val);
+
+        /**
+         * Replaces the contents of the tree with values sorted in increasing order
+         * Builds a balanced tree in O(n)
+         *
+         * @param vector<int>& sorted
+         * @return void
+         */
+        void bulkLoad(vector<int>& sorted);
+
+        /**
+         * Checks whether a value exists in the BST
+         *
+         * @param int val
+         * @return bool
+         */
+        bool exists(int val);
+
+        /**
+         * Returns the number of vertices in the BST
+         *
+         * @return int
+         */
+        int getNumVertices();
+
+        /**
+         * Returns the root of the bst
+         *
+         * @return ThreadedTreeNode*
+         */
+        ThreadedTreeNode* getRoot();
+
+        /**
+         * Returns the first node in order, nullptr for an empty tree
+         *
+         * @return ThreadedTreeNode*
+         */
+        ThreadedTreeNode* first();
+
+        /**
+         * Returns the first node holding a value not less than val, nullptr if none
+         *
+         * @param int val
+         * @return ThreadedTreeNode*
+         */
+        ThreadedTreeNode* lowerBound(int val);
+
+        /**
+         * Returns the in order successor of node, nullptr for the last node
+         * O(1) amortized over a scan
+         *
+         * @param ThreadedTreeNode* node
+         * @return ThreadedTreeNode*
+         */
+        static ThreadedTreeNode* getSuccessor(ThreadedTreeNode* node);
+
+        /**
+         * Appends the values in the range [lo, hi] to res in order
+         *
+         * @param int lo
+         * @param int hi
+         * @param vector<int>& res
+         * @return void
+         */
+        void rangeScan(int lo, int hi, vector<int>& res);
+
+        /**
+         * Returns the entire tree inOrder
+         *
+         * @return vector<int>
+         */
+        vector<int> inOrder();
+};
+
+#endif
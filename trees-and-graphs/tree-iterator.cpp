@@ -0,0 +1,264 @@
+#include "tree-iterator.h"
+
+using namespace std;
+
+/**
+ * These are traversals over a tree of TreeNode* driven by parent pointers
+ * None of them recurse, so degenerate trees can't overflow the stack
+ */
+
+/**
+ * Creates an iterator over the tree rooted at root
+ *
+ * @param TreeNode* root
+ */
+InOrderIterator::InOrderIterator(TreeNode* root)
+{
+    this->root = root;
+
+    this->node = root;
+
+    while (this->node && this->node->left) this->node = this->node->left;
+}
+
+/**
+ * Returns whether there are nodes left to visit
+ *
+ * @return bool
+ */
+bool InOrderIterator::hasNext()
+{
+    return this->node != nullptr;
+}
+
+/**
+ * Returns the next node and advances the iterator
+ *
+ * @return TreeNode*
+ */
+TreeNode* InOrderIterator::nextNode()
+{
+    TreeNode* res = this->node;
+
+    TreeNode* curr = this->node;
+
+    if (curr->right)
+    {
+        curr = curr->right;
+
+        while (curr->left) curr = curr->left;
+
+        this->node = curr;
+
+        return res;
+    }
+
+    // Go up until we leave a left subtree, or the whole tree
+    while (curr != this->root && curr->parent->right == curr) curr = curr->parent;
+
+    this->node = curr == this->root ? nullptr : curr->parent;
+
+    return res;
+}
+
+/**
+ * Returns the next value and advances the iterator
+ *
+ * @return int
+ */
+int InOrderIterator::next()
+{
+    return this->nextNode()->value;
+}
+
+/**
+ * Creates an iterator over the tree rooted at root
+ *
+ * @param TreeNode* root
+ */
+PreOrderIterator::PreOrderIterator(TreeNode* root)
+{
+    this->root = root;
+
+    this->node = root;
+}
+
+/**
+ * Returns whether there are nodes left to visit
+ *
+ * @return bool
+ */
+bool PreOrderIterator::hasNext()
+{
+    return this->node != nullptr;
+}
+
+/**
+ * Returns the next node and advances the iterator
+ *
+ * @return TreeNode*
+ */
+TreeNode* PreOrderIterator::nextNode()
+{
+    TreeNode* res = this->node;
+
+    TreeNode* curr = this->node;
+
+    if (curr->left)
+    {
+        this->node = curr->left;
+
+        return res;
+    }
+
+    if (curr->right)
+    {
+        this->node = curr->right;
+
+        return res;
+    }
+
+    // Go up until we leave a left subtree that has a right sibling
+    while (curr != this->root)
+    {
+        TreeNode* parent = curr->parent;
+
+        if (parent->left == curr && parent->right)
+        {
+            this->node = parent->right;
+
+            return res;
+        }
+
+        curr = parent;
+    }
+
+    this->node = nullptr;
+
+    return res;
+}
+
+/**
+ * Returns the next value and advances the iterator
+ *
+ * @return int
+ */
+int PreOrderIterator::next()
+{
+    return this->nextNode()->value;
+}
+
+/**
+ * Creates an iterator over the tree rooted at root
+ *
+ * @param TreeNode* root
+ */
+LevelOrderIterator::LevelOrderIterator(TreeNode* root)
+{
+    this->root = root;
+
+    this->node = root;
+
+    this->depth = 0;
+}
+
+/**
+ * Returns whether the tree rooted at curr, found at currDepth, reaches depth
+ *
+ * @param TreeNode* curr
+ * @param int currDepth
+ * @return bool
+ */
+bool LevelOrderIterator::reachesDepth(TreeNode* curr, int currDepth)
+{
+    return curr && currDepth + curr->getHeight() - 1 >= this->depth;
+}
+
+/**
+ * Returns the left most node at the current depth in the tree rooted at curr
+ * The tree rooted at curr must reach the current depth
+ *
+ * @param TreeNode* curr
+ * @param int currDepth
+ * @return TreeNode*
+ */
+TreeNode* LevelOrderIterator::leftMostAtDepth(TreeNode* curr, int currDepth)
+{
+    while (currDepth < this->depth)
+    {
+        curr = this->reachesDepth(curr->left, currDepth+1) ? curr->left : curr->right;
+
+        currDepth++;
+    }
+
+    return curr;
+}
+
+/**
+ * Returns whether there are nodes left to visit
+ *
+ * @return bool
+ */
+bool LevelOrderIterator::hasNext()
+{
+    return this->node != nullptr;
+}
+
+/**
+ * Returns the level of the node returned by the next call to next()
+ * The level of the root is 0
+ *
+ * @return int
+ */
+int LevelOrderIterator::getLevel()
+{
+    return this->depth;
+}
+
+/**
+ * Returns the next node and advances the iterator
+ *
+ * @return TreeNode*
+ */
+TreeNode* LevelOrderIterator::nextNode()
+{
+    TreeNode* res = this->node;
+
+    TreeNode* curr = this->node;
+
+    int currDepth = this->depth;
+
+    // Go up until a right sibling subtree reaches the current depth
+    while (curr != this->root)
+    {
+        TreeNode* parent = curr->parent;
+
+        if (parent->left == curr && this->reachesDepth(parent->right, currDepth))
+        {
+            this->node = this->leftMostAtDepth(parent->right, currDepth);
+
+            return res;
+        }
+
+        curr = parent;
+
+        currDepth--;
+    }
+
+    // The current level is done, so start the next one from the root
+    this->depth++;
+
+    this->node = this->reachesDepth(this->root, 0) ? this->leftMostAtDepth(this->root, 0) : nullptr;
+
+    return res;
+}
+
+/**
+ * Returns the next value and advances the iterator
+ *
+ * @return int
+ */
+int LevelOrderIterator::next()
+{
+    return this->nextNode()->value;
+}
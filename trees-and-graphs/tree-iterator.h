@@ -0,0 +1,198 @@
+#ifndef TREE_ITERATOR
+#define TREE_ITERATOR
+
+#include "tree-node.h"
+
+using namespace std;
+
+/**
+ * Streams the values of a tree in order using parent pointers
+ * Uses O(1) extra memory, and no recursion
+ */
+class InOrderIterator
+{
+    private:
+        /**
+         * Root of the tree being iterated
+         *
+         * @param TreeNode* root
+         */
+        TreeNode* root;
+
+        /**
+         * Node returned by the next call to next()
+         *
+         * @param TreeNode* node
+         */
+        TreeNode* node;
+
+    public:
+        /**
+         * Creates an iterator over the tree rooted at root
+         *
+         * @param TreeNode* root
+         */
+        InOrderIterator(TreeNode* root);
+
+        /**
+         * Returns whether there are nodes left to visit
+         *
+         * @return bool
+         */
+        bool hasNext();
+
+        /**
+         * Returns the next node and advances the iterator
+         *
+         * @return TreeNode*
+         */
+        TreeNode* nextNode();
+
+        /**
+         * Returns the next value and advances the iterator
+         *
+         * @return int
+         */
+        int next();
+};
+
+/**
+ * Streams the values of a tree in pre order using parent pointers
+ * Uses O(1) extra memory, and no recursion
+ */
+class PreOrderIterator
+{
+    private:
+        /**
+         * Root of the tree being iterated
+         *
+         * @param TreeNode* root
+         */
+        TreeNode* root;
+
+        /**
+         * Node returned by the next call to next()
+         *
+         * @param TreeNode* node
+         */
+        TreeNode* node;
+
+    public:
+        /**
+         * Creates an iterator over the tree rooted at root
+         *
+         * @param TreeNode* root
+         */
+        PreOrderIterator(TreeNode* root);
+
+        /**
+         * Returns whether there are nodes left to visit
+         *
+         * @return bool
+         */
+        bool hasNext();
+
+        /**
+         * Returns the next node and advances the iterator
+         *
+         * @return TreeNode*
+         */
+        TreeNode* nextNode();
+
+        /**
+         * Returns the next value and advances the iterator
+         *
+         * @return int
+         */
+        int next();
+};
+
+/**
+ * Streams the values of a tree level by level using parent pointers
+ * Each level is found by a walk guided by the stored subtree heights
+ * Uses O(1) extra memory, but O(n * height) time, which is O(n^2) on a degenerate
+ * Tree, so it is only for when memory is tight
+ * BinarySearchTree::levelOrder fills buffers in O(n) time with an O(n) queue
+ */
+class LevelOrderIterator
+{
+    private:
+        /**
+         * Root of the tree being iterated
+         *
+         * @param TreeNode* root
+         */
+        TreeNode* root;
+
+        /**
+         * Node returned by the next call to next()
+         *
+         * @param TreeNode* node
+         */
+        TreeNode* node;
+
+        /**
+         * Depth of node below the root
+         *
+         * @param int depth
+         */
+        int depth;
+
+        /**
+         * Returns whether the tree rooted at curr, found at depth, reaches depth
+         *
+         * @param TreeNode* curr
+         * @param int currDepth
+         * @return bool
+         */
+        bool reachesDepth(TreeNode* curr, int currDepth);
+
+        /**
+         * Returns the left most node at the current depth in the tree rooted at curr
+         * The tree rooted at curr must reach the current depth
+         *
+         * @param TreeNode* curr
+         * @param int currDepth
+         * @return TreeNode*
+         */
+        TreeNode* leftMostAtDepth(TreeNode* curr, int currDepth);
+
+    public:
+        /**
+         * Creates an iterator over the tree rooted at root
+         *
+         * @param TreeNode* root
+         */
+        LevelOrderIterator(TreeNode* root);
+
+        /**
+         * Returns whether there are nodes left to visit
+         *
+         * @return bool
+         */
+        bool hasNext();
+
+        /**
+         * Returns the level of the node returned by the next call to next()
+         * The level of the root is 0
+         *
+         * @return int
+         */
+        int getLevel();
+
+        /**
+         * Returns the next node and advances the iterator
+         *
+         * @return TreeNode*
+         */
+        TreeNode* nextNode();
+
+        /**
+         * Returns the next value and advances the iterator
+         *
+         * @return int
+         */
+        int next();
+};
+
+#endif
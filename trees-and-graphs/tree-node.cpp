@@ -16,7 +16,21 @@ TreeNode::TreeNode(int val)
 
     this->left = nullptr;
 
+    this->parent = nullptr;
+
     this->height = 1;
+
+    this->size = 1;
+
+    this->unbalanced = false;
+
+    this->touched = true;
+
+    this->pooled = false;
+
+    this->sum = val;
+
+    this->setHash();
 }
 
 /**
@@ -116,6 +130,104 @@ void TreeNode::setHeight()
     this->height = 1 + max(heightL, heightR);
 }
 
+/**
+ * Returns the number of nodes in the tree
+ *
+ * @return int
+ */
+int TreeNode::getSize()
+{
+    return this->size;
+}
+
+/**
+ * Sets the number of nodes in the tree
+ *
+ * @return void
+ */
+void TreeNode::setSize()
+{
+    int sizeL = this->left ? this->left->getSize() : 0;
+
+    int sizeR = this->right ? this->right->getSize() : 0;
+
+    this->size = 1 + sizeL + sizeR;
+}
+
+/**
+ * Returns the sum of the values in the tree
+ *
+ * @return long long
+ */
+long long TreeNode::getSum()
+{
+    return this->sum;
+}
+
+/**
+ * Sets the sum of the values in the tree
+ *
+ * @return void
+ */
+void TreeNode::setSum()
+{
+    long long sumL = this->left ? this->left->getSum() : 0;
+
+    long long sumR = this->right ? this->right->getSum() : 0;
+
+    this->sum = this->value + sumL + sumR;
+}
+
+/**
+ * Returns the structural hash of the tree
+ *
+ * @return unsigned long long
+ */
+unsigned long long TreeNode::getHash()
+{
+    return this->hash;
+}
+
+/**
+ * Sets the structural hash of the tree
+ * Equal trees have equal hashes, and left / right children are not interchangeable
+ *
+ * @return void
+ */
+void TreeNode::setHash()
+{
+    unsigned long long hashL = this->left ? this->left->getHash() : EMPTY_HASH;
+
+    unsigned long long hashR = this->right ? this->right->getHash() : EMPTY_HASH;
+
+    this->hash = combineHash(this->value, hashL, hashR);
+}
+
+/**
+ * Returns the structural hash of a node holding value over children with the given hashes
+ * A missing child has the hash EMPTY_HASH
+ *
+ * @param int value
+ * @param unsigned long long hashL
+ * @param unsigned long long hashR
+ * @return unsigned long long
+ */
+unsigned long long TreeNode::combineHash(int value, unsigned long long hashL, unsigned long long hashR)
+{
+    unsigned long long h = (unsigned long long) (unsigned int) value;
+
+    h = h * 0xff51afd7ed558ccdULL + hashL;
+
+    h = (h ^ (h >> 29)) * 0xc4ceb9fe1a85ec53ULL + hashR;
+
+    // Final avalanche step of splitmix64
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+
+    return h ^ (h >> 31);
+}
+
 /**
  * Increments the height of the tree
  *
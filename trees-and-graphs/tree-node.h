@@ -1,6 +1,11 @@
 #ifndef TREE_NODE
 #define TREE_NODE
 
+/**
+ * Structural hash of a missing child
+ */
+const unsigned long long EMPTY_HASH = 0x9e3779b97f4a7c15ULL;
+
 class TreeNode
 {
     public:
@@ -19,6 +24,51 @@ class TreeNode
          */
         int height;
 
+        /**
+         * Number of nodes in the tree rooted at this node
+         * Recursively defined as 1 + size(left) + size(right)
+         *
+         * @param int size
+         */
+        int size;
+
+        /**
+         * Whether the heights of the left and right trees differ by more than 1
+         * As of the last time the node was updated
+         *
+         * @param bool unbalanced
+         */
+        bool unbalanced;
+
+        /**
+         * Whether the node was created or updated since it was last validated
+         *
+         * @param bool touched
+         */
+        bool touched;
+
+        /**
+         * Whether the node lives in a pool allocated by bulkLoad, and so is never deleted alone
+         *
+         * @param bool pooled
+         */
+        bool pooled;
+
+        /**
+         * Sum of the values in the tree rooted at this node
+         *
+         * @param long long sum
+         */
+        long long sum;
+
+        /**
+         * Structural hash of the tree rooted at this node
+         * Combines the value with the hashes of both children
+         *
+         * @param unsigned long long hash
+         */
+        unsigned long long hash;
+
         /**
          * Left child of the node
          *
@@ -109,6 +159,59 @@ class TreeNode
          */
         void setHeight();
 
+        /**
+         * Returns the number of nodes in the tree rooted at this node
+         *
+         * @return int
+         */
+        int getSize();
+
+        /**
+         * Sets the number of nodes in the tree rooted at this node
+         *
+         * @return void
+         */
+        void setSize();
+
+        /**
+         * Returns the sum of the values in the tree rooted at this node
+         *
+         * @return long long
+         */
+        long long getSum();
+
+        /**
+         * Sets the sum of the values in the tree rooted at this node
+         *
+         * @return void
+         */
+        void setSum();
+
+        /**
+         * Returns the structural hash of the tree rooted at this node
+         *
+         * @return unsigned long long
+         */
+        unsigned long long getHash();
+
+        /**
+         * Sets the structural hash of the tree rooted at this node
+         *
+         * @return void
+         */
+        void setHash();
+
+        /**
+         * Returns the structural hash of a node holding value over children with the given hashes
+         * A missing child has the hash EMPTY_HASH
+         *
+         * @param int value
+         * @param unsigned long long hashL
+         * @param unsigned long long hashR
+         * @return unsigned long long
+         */
+        static unsigned long long combineHash(int value, unsigned long long hashL, unsigned long long hashR);
+
         /**
          * Increment the right of this tree
          *
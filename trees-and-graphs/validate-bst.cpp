@@ -1,7 +1,9 @@
 #include "binary-search-tree.cpp"
+#include "bst-validator.cpp"
 #include <vector>
 #include <iostream>
 #include <list>
+#include <limits>
 
 using namespace std;
 
@@ -11,49 +13,15 @@ using namespace std;
  * @see binary-search-tree.cpp
  */
 
-/**
- * Creates a tree of minimal height
- *
- * @param BinarySearchTree& bst
- * @param vectorint>& v
- * @param int start
- * @param int end
- * @return void
- */
-void minimalTree(BinarySearchTree& bst, vector<int>& v, int start, int end)
-{
-    if (start > end) return;
-
-    int mid = (start + end) / 2;
-
-    bst.insert(v[mid]);
-
-    minimalTree(bst, v, start, mid-1);
-
-    minimalTree(bst, v, mid+1, end);
-}
-
-/**
- * Creates a tree of minimal height
- *
- * @param BinarySearchTree& bst
- * @param vectorint>& v
- * @return void
- */
-void minimalTree(BinarySearchTree& bst, vector<int>& v)
-{
-    minimalTree(bst, v, 0, v.size()-1);
-}
-
-bool isBST(TreeNode* root, int& prev)
+bool isBST(TreeNode* root, TreeNode*& prev)
 {
     if (!root) return true;
 
     else if (!isBST(root->left, prev)) return false;
 
-    else if (prev != -1 && prev > root->value) return false;
+    else if (prev && prev->value > root->value) return false;
 
-    prev = root->value;
+    prev = root;
 
     return isBST(root->right, prev);
 }
@@ -62,12 +30,13 @@ bool isBST(TreeNode* root)
 {
     if (!root) return true;
 
-    int prev = -1;
+    TreeNode* prev = nullptr;
 
     return isBST(root, prev);
 }
 
-bool isBST(TreeNode* node, int min, int max)
+// long long bounds, so the open ends sit outside every int value
+bool isBST(TreeNode* node, long long min, long long max)
 {
     if (!node) return true;
 
@@ -107,6 +76,20 @@ TreeNode* createBinaryTree()
     return root;
 }
 
+// addLeftChild and addRightChild leave the heights and sizes to the caller
+void setCounts(TreeNode* node)
+{
+    if (!node) return;
+
+    setCounts(node->left);
+
+    setCounts(node->right);
+
+    node->setHeight();
+
+    node->setSize();
+}
+
 int main()
 {
     BinarySearchTree bst = BinarySearchTree();
@@ -117,7 +100,7 @@ int main()
 
     cout << endl;
 
-    minimalTree(bst, v);
+    bst.bulkLoad(v);
 
     printf("The height of the tree after insertion %d\n", bst.getHeight());
 
@@ -127,14 +110,16 @@ int main()
 
     cout << endl;
 
-    int min = numeric_limits<int>::min();
+    long long min = numeric_limits<long long>::min();
 
-    int max = numeric_limits<int>::max();
+    long long max = numeric_limits<long long>::max();
 
     printf("Checking to see if the tree is a BST using min/max %d\n", isBST(bst.getRoot(), min, max));
 
     TreeNode* BT = createBinaryTree();
 
+    setCounts(BT);
+
     cout << endl;
 
     printf("Checking to see if the tree is a BST %d\n", isBST(BT));
@@ -142,4 +127,30 @@ int main()
     cout << endl;
 
     printf("Checking to see if the tree is a BST using min/max %d\n", isBST(BT, min, max));
+
+    BstValidator validator(thread::hardware_concurrency());
+
+    cout << endl;
+
+    bool valid = validator.validate(bst.getRoot());
+
+    printf("Validating the tree %d, checked %lld nodes\n", valid, validator.getNumChecked());
+
+    bst.insert(numeric_limits<int>::min());
+
+    bst.insert(numeric_limits<int>::max());
+
+    printf("Checking to see if the tree is a BST with INT_MIN and INT_MAX using min/max %d\n", isBST(bst.getRoot(), min, max));
+
+    valid = validator.validateTouched(bst.getRoot());
+
+    printf("Validating the touched paths %d, checked %lld nodes\n", valid, validator.getNumChecked());
+
+    valid = validator.validateTouched(bst.getRoot());
+
+    printf("Validating the touched paths again %d, checked %lld nodes\n", valid, validator.getNumChecked());
+
+    valid = validator.validate(BT);
+
+    printf("Validating the binary tree %d, violation at %d, %s\n", valid, validator.getViolation()->value, validator.getReason());
 }